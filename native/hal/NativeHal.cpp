@@ -0,0 +1,146 @@
+#include "NativeHal.h"
+
+#include <Arduino.h>
+#include <CyLib.h>
+#include <EEPROM.h>
+#include <LoRaWan_APP.h>
+#include <string.h>
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+namespace Native {
+
+namespace {
+uint64_t clockMicros = 0;
+Board defaultBoard;
+Board *board = &defaultBoard;
+Hal::IdleHook idleHook = nullptr;
+} // namespace
+
+Board::Board(uint32_t seed, uint32_t chipId) : rngState(1), chipId(chipId) {
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  reseed(seed);
+}
+
+void Board::reseed(uint32_t seed) {
+  // xorshift32 must never hold zero
+  rngState = seed != 0 ? seed : 0x9E3779B9u;
+}
+
+uint32_t Board::nextRandom() {
+  uint32_t x = rngState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rngState = x;
+  return x;
+}
+
+namespace Hal {
+
+uint64_t nowMicros() { return clockMicros; }
+
+void setMicros(uint64_t us) { clockMicros = us; }
+
+void advanceMicros(uint64_t us) { clockMicros += us; }
+
+void advanceMillis(uint32_t ms) { clockMicros += static_cast<uint64_t>(ms) * 1000; }
+
+void setActiveBoard(Board *newBoard) {
+  board = (newBoard != nullptr) ? newBoard : &defaultBoard;
+}
+
+Board &activeBoard() { return *board; }
+
+void setIdleHook(IdleHook hook) { idleHook = hook; }
+
+} // namespace Hal
+
+} // namespace Native
+
+uint32_t millis() {
+  return static_cast<uint32_t>(Native::Hal::nowMicros() / 1000);
+}
+
+uint32_t micros() { return static_cast<uint32_t>(Native::Hal::nowMicros()); }
+
+void delay(uint32_t ms) { Native::Hal::advanceMillis(ms); }
+
+void delayMicroseconds(uint32_t us) { Native::Hal::advanceMicros(us); }
+
+long random(long max) {
+  if (max <= 0) {
+    return 0;
+  }
+  return static_cast<long>(Native::Hal::activeBoard().nextRandom() %
+                           static_cast<unsigned long>(max));
+}
+
+long random(long min, long max) {
+  if (min >= max) {
+    return min;
+  }
+  return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+  Native::Hal::activeBoard().reseed(static_cast<uint32_t>(seed));
+}
+
+uint16_t analogRead(uint8_t pin) {
+  // 12-bit ADC noise
+  return static_cast<uint16_t>(Native::Hal::activeBoard().nextRandom() & 0x0FFF);
+}
+
+uint8_t CY_GET_XTND_REG8(const void *address) {
+  uint32_t chipId = Native::Hal::activeBoard().chipId;
+  switch (reinterpret_cast<uintptr_t>(address)) {
+  case CYREG_SFLASH_DIE_LOT0:
+    return static_cast<uint8_t>(chipId);
+  case CYREG_SFLASH_DIE_WAFER:
+    return static_cast<uint8_t>(chipId >> 8);
+  case CYREG_SFLASH_DIE_X:
+    return static_cast<uint8_t>(chipId >> 16);
+  case CYREG_SFLASH_DIE_Y:
+    return static_cast<uint8_t>(chipId >> 24);
+  default:
+    return 0;
+  }
+}
+
+uint8_t EEPROMClass::read(int address) {
+  if (address < 0 || static_cast<size_t>(address) >= Native::Board::EEPROM_SIZE) {
+    return 0xFF;
+  }
+  return Native::Hal::activeBoard().eeprom[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address < 0 || static_cast<size_t>(address) >= Native::Board::EEPROM_SIZE) {
+    return;
+  }
+  Native::Hal::activeBoard().eeprom[address] = value;
+}
+
+extern "C" void lowPowerHandler(void) {
+  if (Native::idleHook != nullptr) {
+    Native::idleHook();
+  }
+}
+
+void TimerInit(TimerEvent_t *obj, void (*callback)(void)) {
+  memset(obj, 0, sizeof(*obj));
+  obj->Callback = callback;
+}
+
+void TimerSetValue(TimerEvent_t *obj, uint32_t value) {
+  obj->ReloadValue = value;
+}
+
+void TimerStart(TimerEvent_t *obj) {
+  obj->Timestamp = millis() + obj->ReloadValue;
+  obj->IsRunning = true;
+}
+
+void TimerStop(TimerEvent_t *obj) { obj->IsRunning = false; }
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Native {
+
+/**
+ * Per-device state the real hardware keeps on-chip: EEPROM contents,
+ * the PRNG behind random() and the die id read through CyLib.
+ * Swapping the active board lets one process host several nodes.
+ */
+struct Board {
+  static constexpr size_t EEPROM_SIZE = 512;
+
+  uint8_t eeprom[EEPROM_SIZE];
+  uint32_t rngState;
+  uint32_t chipId;
+
+  explicit Board(uint32_t seed = 1, uint32_t chipId = 0x5A3C7E11u);
+  void reseed(uint32_t seed);
+  uint32_t nextRandom();
+};
+
+/**
+ * Virtual clock and board selection backing the Arduino shim.
+ * Time only moves when the host driver or delay() advances it.
+ */
+namespace Hal {
+
+uint64_t nowMicros();
+void setMicros(uint64_t us);
+void advanceMicros(uint64_t us);
+void advanceMillis(uint32_t ms);
+
+void setActiveBoard(Board *board);
+Board &activeBoard();
+
+// Called from lowPowerHandler(); lets the driver decide what "sleep" means
+typedef void (*IdleHook)();
+void setIdleHook(IdleHook hook);
+
+} // namespace Hal
+
+} // namespace Native
@@ -0,0 +1,142 @@
+#include "NativeRadio.h"
+
+#include <string.h>
+
+namespace Native {
+
+namespace {
+RadioState defaultState;
+RadioState *state = &defaultState;
+RadioMedium *medium = nullptr;
+
+bool latch(RadioState &target, RadioState::IrqType type, const uint8_t *frame,
+           uint16_t size, int16_t rssi, int8_t snr) {
+  if (target.pendingCount >= RadioState::MAX_PENDING_IRQS) {
+    target.overrunCount++;
+    return false;
+  }
+  RadioState::PendingIrq &irq = target.pending[target.pendingCount++];
+  irq.type = type;
+  irq.rssi = rssi;
+  irq.snr = snr;
+  irq.size = size > RadioState::MAX_FRAME_SIZE ? RadioState::MAX_FRAME_SIZE : size;
+  if (frame != nullptr && irq.size > 0) {
+    memcpy(irq.frame, frame, irq.size);
+  }
+  return true;
+}
+
+void radioInit(RadioEvents_t *events) {
+  state->events = events;
+  state->receiving = false;
+  state->transmitting = false;
+  state->pendingCount = 0;
+}
+
+void radioSetChannel(uint32_t freq) {}
+
+void radioSetRxConfig(RadioModems_t modem, uint32_t bandwidth, uint32_t datarate,
+                      uint8_t coderate, uint32_t bandwidthAfc,
+                      uint16_t preambleLen, uint16_t symbTimeout, bool fixLen,
+                      uint8_t payloadLen, bool crcOn, bool freqHopOn,
+                      uint8_t hopPeriod, bool iqInverted, bool rxContinuous) {}
+
+void radioSetTxConfig(RadioModems_t modem, int8_t power, uint32_t fdev,
+                      uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                      uint16_t preambleLen, bool fixLen, bool crcOn,
+                      bool freqHopOn, uint8_t hopPeriod, bool iqInverted,
+                      uint32_t timeout) {}
+
+void radioSetSyncWord(uint8_t syncWord) {}
+
+void radioSend(uint8_t *buffer, uint8_t size) {
+  state->receiving = false;
+  state->transmitting = true;
+  if (medium != nullptr) {
+    medium->onTransmit(buffer, size);
+  }
+}
+
+void radioSleep() {
+  state->receiving = false;
+  state->transmitting = false;
+}
+
+void radioStandby() {
+  state->receiving = false;
+  state->transmitting = false;
+}
+
+void radioRx(uint32_t timeout) {
+  state->receiving = true;
+  state->transmitting = false;
+}
+
+void radioIrqProcess() {
+  RadioState &radio = *state;
+  if (radio.events == nullptr) {
+    radio.pendingCount = 0;
+    return;
+  }
+
+  // Callbacks may latch new interrupts, so drain from the front
+  uint8_t index = 0;
+  while (index < radio.pendingCount) {
+    RadioState::PendingIrq irq = radio.pending[index++];
+    switch (irq.type) {
+    case RadioState::IrqType::RX_DONE:
+      if (radio.events->RxDone != nullptr) {
+        radio.events->RxDone(irq.frame, irq.size, irq.rssi, irq.snr);
+      }
+      break;
+    case RadioState::IrqType::TX_DONE:
+      radio.transmitting = false;
+      if (radio.events->TxDone != nullptr) {
+        radio.events->TxDone();
+      }
+      break;
+    case RadioState::IrqType::TX_TIMEOUT:
+      radio.transmitting = false;
+      if (radio.events->TxTimeout != nullptr) {
+        radio.events->TxTimeout();
+      }
+      break;
+    }
+  }
+  radio.pendingCount = 0;
+}
+
+} // namespace
+
+namespace RadioHal {
+
+void setActive(RadioState *newState) {
+  state = (newState != nullptr) ? newState : &defaultState;
+}
+
+RadioState &active() { return *state; }
+
+void setMedium(RadioMedium *newMedium) { medium = newMedium; }
+
+bool raiseRxDone(RadioState &target, const uint8_t *frame, uint16_t size,
+                 int16_t rssi, int8_t snr) {
+  return latch(target, RadioState::IrqType::RX_DONE, frame, size, rssi, snr);
+}
+
+bool raiseTxDone(RadioState &target) {
+  return latch(target, RadioState::IrqType::TX_DONE, nullptr, 0, 0, 0);
+}
+
+bool raiseTxTimeout(RadioState &target) {
+  return latch(target, RadioState::IrqType::TX_TIMEOUT, nullptr, 0, 0, 0);
+}
+
+} // namespace RadioHal
+
+} // namespace Native
+
+const struct Radio_s Radio = {
+    Native::radioInit,        Native::radioSetChannel, Native::radioSetRxConfig,
+    Native::radioSetTxConfig, Native::radioSetSyncWord, Native::radioSend,
+    Native::radioSleep,       Native::radioStandby,    Native::radioRx,
+    Native::radioRx,          Native::radioIrqProcess};
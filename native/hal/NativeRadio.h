@@ -0,0 +1,59 @@
+#pragma once
+
+#include <LoRaWan_APP.h>
+#include <stdint.h>
+
+namespace Native {
+
+/**
+ * Receives frames handed to Radio.Send(). The host driver prints them,
+ * the simulator puts them on its virtual channel.
+ */
+class RadioMedium {
+public:
+  virtual ~RadioMedium() = default;
+  virtual void onTransmit(const uint8_t *data, uint8_t size) = 0;
+};
+
+/**
+ * State of one SX126x: registered callbacks and latched interrupts.
+ * Interrupts raised by the medium are delivered on the next
+ * Radio.IrqProcess(), exactly like the framework's DIO1 handling.
+ */
+struct RadioState {
+  static constexpr uint8_t MAX_PENDING_IRQS = 4;
+  static constexpr uint16_t MAX_FRAME_SIZE = 255;
+
+  enum class IrqType : uint8_t { RX_DONE, TX_DONE, TX_TIMEOUT };
+
+  struct PendingIrq {
+    IrqType type;
+    int16_t rssi;
+    int8_t snr;
+    uint16_t size;
+    uint8_t frame[MAX_FRAME_SIZE];
+  };
+
+  RadioEvents_t *events = nullptr;
+  bool receiving = false;
+  bool transmitting = false;
+  PendingIrq pending[MAX_PENDING_IRQS];
+  uint8_t pendingCount = 0;
+  uint32_t overrunCount = 0;
+};
+
+namespace RadioHal {
+
+void setActive(RadioState *state);
+RadioState &active();
+void setMedium(RadioMedium *medium);
+
+// Latch interrupts on a radio; delivered by its next Radio.IrqProcess()
+bool raiseRxDone(RadioState &state, const uint8_t *frame, uint16_t size,
+                 int16_t rssi, int8_t snr);
+bool raiseTxDone(RadioState &state);
+bool raiseTxTimeout(RadioState &state);
+
+} // namespace RadioHal
+
+} // namespace Native
@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * Host stand-in for the CubeCell Arduino core.
+ *
+ * Only the subset of the Arduino API used by the firmware is provided.
+ * Time is virtual and owned by Native::Hal, so the pipeline runs
+ * deterministically on a workstation.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t *>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t *>(addr))
+
+#define ADC 0
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+uint16_t analogRead(uint8_t pin);
+
+template <typename T> inline const T &min(const T &a, const T &b) {
+  return (b < a) ? b : a;
+}
+
+template <typename T> inline const T &max(const T &a, const T &b) {
+  return (a < b) ? b : a;
+}
+
+class HardwareSerial {
+public:
+  void begin(uint32_t baudRate) {}
+  void print(const char *text) { fputs(text, stdout); }
+  void print(char c) { fputc(c, stdout); }
+  void print(int value) { printf("%d", value); }
+  void print(unsigned int value) { printf("%u", value); }
+  void print(long value) { printf("%ld", value); }
+  void print(unsigned long value) { printf("%lu", value); }
+  void println() { fputc('\n', stdout); }
+  void println(const char *text) {
+    fputs(text, stdout);
+    fputc('\n', stdout);
+  }
+  void flush() { fflush(stdout); }
+};
+
+extern HardwareSerial Serial;
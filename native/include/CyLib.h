@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host stand-in for the PSoC CyLib register accessors used to read the
+ * die identification registers. Values come from the active
+ * Native::Hal board's chip id.
+ */
+
+#define CYREG_SFLASH_DIE_LOT0 0x0FFFF1E8u
+#define CYREG_SFLASH_DIE_WAFER 0x0FFFF1EBu
+#define CYREG_SFLASH_DIE_X 0x0FFFF1ECu
+#define CYREG_SFLASH_DIE_Y 0x0FFFF1EDu
+
+uint8_t CY_GET_XTND_REG8(const void *address);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the CubeCell flash-emulated EEPROM.
+ * Contents live in the active Native::Hal board, so every simulated
+ * node keeps its own identity and location.
+ */
+class EEPROMClass {
+public:
+  void begin(size_t size) {}
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit() { return true; }
+  void end() {}
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the SX126x radio driver exposed by LoRaWan_APP.h.
+ * Mirrors the framework's RadioEvents_t / Radio_s layout; the calls are
+ * routed to Native::RadioHal (see native/hal/NativeRadio.h).
+ */
+
+typedef enum { MODEM_FSK = 0, MODEM_LORA } RadioModems_t;
+
+typedef struct {
+  void (*TxDone)(void);
+  void (*TxTimeout)(void);
+  void (*RxDone)(uint8_t *payload, uint16_t size, int16_t rssi, int8_t snr);
+  void (*RxTimeout)(void);
+  void (*RxError)(void);
+  void (*FhssChangeChannel)(uint8_t currentChannel);
+  void (*CadDone)(bool channelActivityDetected);
+} RadioEvents_t;
+
+struct Radio_s {
+  void (*Init)(RadioEvents_t *events);
+  void (*SetChannel)(uint32_t freq);
+  void (*SetRxConfig)(RadioModems_t modem, uint32_t bandwidth,
+                      uint32_t datarate, uint8_t coderate,
+                      uint32_t bandwidthAfc, uint16_t preambleLen,
+                      uint16_t symbTimeout, bool fixLen, uint8_t payloadLen,
+                      bool crcOn, bool freqHopOn, uint8_t hopPeriod,
+                      bool iqInverted, bool rxContinuous);
+  void (*SetTxConfig)(RadioModems_t modem, int8_t power, uint32_t fdev,
+                      uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                      uint16_t preambleLen, bool fixLen, bool crcOn,
+                      bool freqHopOn, uint8_t hopPeriod, bool iqInverted,
+                      uint32_t timeout);
+  void (*SetSyncWord)(uint8_t syncWord);
+  void (*Send)(uint8_t *buffer, uint8_t size);
+  void (*Sleep)(void);
+  void (*Standby)(void);
+  void (*Rx)(uint32_t timeout);
+  void (*RxBoosted)(uint32_t timeout);
+  void (*IrqProcess)(void);
+};
+
+extern const struct Radio_s Radio;
+
+// Framework RTC timers (timer.h). Host drivers step the clock themselves
+// and lowPowerHandler() returns at once, so timers are only bookkept.
+typedef struct TimerEvent_s {
+  uint32_t Timestamp;
+  uint32_t ReloadValue;
+  bool IsRunning;
+  void (*Callback)(void);
+  struct TimerEvent_s *Next;
+} TimerEvent_t;
+
+void TimerInit(TimerEvent_t *obj, void (*callback)(void));
+void TimerSetValue(TimerEvent_t *obj, uint32_t value);
+void TimerStart(TimerEvent_t *obj);
+void TimerStop(TimerEvent_t *obj);
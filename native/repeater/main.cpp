@@ -0,0 +1,142 @@
+// Host driver for the unmodified firmware in src/main.cpp.
+//
+// Reads commands from stdin, feeds frames to the radio as RX interrupts,
+// runs loop() on the virtual clock and prints every transmitted frame.
+//
+//   <hex> [rssi [snr]]   inject a received frame (default -80 dBm, 8 dB)
+//   wait <ms>            run the firmware for <ms> of virtual time
+//   # ...                comment
+//
+// Options: --seed <n> (PRNG seed), --settle <ms> (run time after EOF)
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/radio/LoRaTransmitter.h"
+#include "../hal/NativeHal.h"
+#include "../hal/NativeRadio.h"
+
+void setup();
+void loop();
+
+namespace {
+
+class DriverMedium : public Native::RadioMedium {
+public:
+  DriverMedium() : txPending(false), txDoneAt(0) {}
+
+  void onTransmit(const uint8_t *data, uint8_t size) override {
+    printf("TX t=%u len=%u ", millis(), size);
+    for (uint8_t i = 0; i < size; ++i) {
+      printf("%02x", data[i]);
+    }
+    printf("\n");
+    txPending = true;
+    txDoneAt = millis() + LoRaTransmitter::estimateAirtime(size);
+  }
+
+  void poll() {
+    if (txPending && millis() >= txDoneAt) {
+      txPending = false;
+      Native::RadioHal::raiseTxDone(Native::RadioHal::active());
+    }
+  }
+
+private:
+  bool txPending;
+  uint32_t txDoneAt;
+};
+
+DriverMedium medium;
+
+void runFor(uint32_t durationMs) {
+  for (uint32_t i = 0; i < durationMs; ++i) {
+    medium.poll();
+    loop();
+    Native::Hal::advanceMillis(1);
+  }
+}
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+uint16_t parseHex(const char *text, uint8_t *out, uint16_t maxLen) {
+  uint16_t len = 0;
+  while (text[0] != '\0' && text[1] != '\0' && len < maxLen) {
+    int hi = hexValue(text[0]);
+    int lo = hexValue(text[1]);
+    if (hi < 0 || lo < 0) {
+      break;
+    }
+    out[len++] = static_cast<uint8_t>((hi << 4) | lo);
+    text += 2;
+  }
+  return len;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t seed = 1;
+  uint32_t settleMs = 10000;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (strcmp(argv[i], "--settle") == 0 && i + 1 < argc) {
+      settleMs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else {
+      fprintf(stderr, "usage: %s [--seed n] [--settle ms] < frames\n", argv[0]);
+      return 2;
+    }
+  }
+
+  Native::Hal::activeBoard().reseed(seed);
+  Native::RadioHal::setMedium(&medium);
+
+  setup();
+
+  char line[1024];
+  while (fgets(line, sizeof(line), stdin) != nullptr) {
+    if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') {
+      continue;
+    }
+
+    if (strncmp(line, "wait", 4) == 0) {
+      runFor(static_cast<uint32_t>(strtoul(line + 4, nullptr, 10)));
+      continue;
+    }
+
+    char hex[600];
+    int rssi = -80;
+    int snr = 8;
+    if (sscanf(line, "%599s %d %d", hex, &rssi, &snr) < 1) {
+      continue;
+    }
+
+    uint8_t frame[Native::RadioState::MAX_FRAME_SIZE];
+    uint16_t length = parseHex(hex, frame, sizeof(frame));
+    if (length == 0) {
+      fprintf(stderr, "ignoring malformed frame: %s", line);
+      continue;
+    }
+
+    printf("RX t=%u len=%u rssi=%d snr=%d\n", millis(), length, rssi, snr);
+    Native::RadioHal::raiseRxDone(Native::RadioHal::active(), frame, length,
+                                  static_cast<int16_t>(rssi),
+                                  static_cast<int8_t>(snr));
+    runFor(1);
+  }
+
+  runFor(settleMs);
+  return 0;
+}
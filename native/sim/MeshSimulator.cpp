@@ -0,0 +1,327 @@
+#include "MeshSimulator.h"
+
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "../../src/core/PacketDecoder.h"
+#include "../../src/radio/LoRaTransmitter.h"
+
+namespace Sim {
+
+namespace {
+
+constexpr uint8_t MESSAGE_ID_SIZE = 4;
+constexpr float MAX_LINK_SNR_DB = 12.0f;
+constexpr float LINK_MARGIN_DB = 6.0f;  // Below floor - margin a link is never usable
+constexpr float MIN_DISTANCE = 0.1f;
+
+// Seen-packet cache pressure, whichever Deduplication::BACKEND is built
+template <size_t SIZE, uint32_t TIMEOUT_MS>
+void addCacheStats(const MeshCore::ExpiringHashSet<SIZE, TIMEOUT_MS> &cache,
+                   SimulationReport &report) {
+  report.dedupEvictions += cache.getEvictionCount();
+}
+
+template <size_t BITS, uint8_t HASHES, uint32_t WINDOW_MS>
+void addCacheStats(const MeshCore::TimedBloomFilter<BITS, HASHES, WINDOW_MS> &cache,
+                   SimulationReport &report) {
+  report.dedupDecoyChecks += cache.getDecoyCheckCount();
+  report.dedupFalsePositives += cache.getFalsePositiveCount();
+}
+
+uint16_t defaultNodeCount(Topology topology) {
+  switch (topology) {
+  case Topology::LINE:
+    return 8;
+  case Topology::GRID:
+    return 16;
+  case Topology::CLUSTER:
+    return 12;
+  }
+  return 8;
+}
+
+} // namespace
+
+MeshSimulator::MeshSimulator(Topology topology, const SimulationParams &params)
+    : topology(topology), params(params), rng(params.seed ^ 0x5EEDull),
+      nodeCount(params.nodeCount != 0 ? params.nodeCount
+                                      : defaultNodeCount(topology)),
+      nodes(nullptr), channel(nullptr), records(nullptr), nowMs(0),
+      activeNode(-1), newReceivers(0), relayTransmissions(0),
+      redundantTransmissions(0) {
+  if (nodeCount < 2) {
+    nodeCount = 2;
+  }
+  if (nodeCount > MAX_NODES) {
+    nodeCount = MAX_NODES;
+  }
+  memset(posX, 0, sizeof(posX));
+  memset(posY, 0, sizeof(posY));
+}
+
+MeshSimulator::~MeshSimulator() {
+  delete[] records;
+  delete channel;
+  delete[] nodes;
+}
+
+const char *MeshSimulator::topologyName(Topology topology) {
+  switch (topology) {
+  case Topology::LINE:
+    return "line";
+  case Topology::GRID:
+    return "grid";
+  case Topology::CLUSTER:
+    return "cluster";
+  }
+  return "?";
+}
+
+void MeshSimulator::placeNodes() {
+  switch (topology) {
+  case Topology::LINE:
+    for (uint16_t i = 0; i < nodeCount; ++i) {
+      posX[i] = static_cast<float>(i);
+    }
+    break;
+  case Topology::GRID: {
+    uint16_t cols = static_cast<uint16_t>(ceil(sqrt(static_cast<double>(nodeCount))));
+    for (uint16_t i = 0; i < nodeCount; ++i) {
+      posX[i] = static_cast<float>(i % cols);
+      posY[i] = static_cast<float>(i / cols);
+    }
+    break;
+  }
+  case Topology::CLUSTER:
+    // Dense deployment: most nodes hear each other directly
+    for (uint16_t i = 0; i < nodeCount; ++i) {
+      posX[i] = static_cast<float>(rng.uniform() * 0.8);
+      posY[i] = static_cast<float>(rng.uniform() * 0.8);
+    }
+    break;
+  }
+}
+
+void MeshSimulator::buildLinks() {
+  float floorDb = VirtualChannel::demodulationFloorDb();
+  for (uint16_t a = 0; a < nodeCount; ++a) {
+    for (uint16_t b = a + 1; b < nodeCount; ++b) {
+      float dx = posX[a] - posX[b];
+      float dy = posY[a] - posY[b];
+      float distance = std::max(sqrtf(dx * dx + dy * dy), MIN_DISTANCE);
+      float snr = params.snrAtUnitDb -
+                  10.0f * params.pathLossExponent * log10f(distance) +
+                  static_cast<float>(rng.gaussian(0.0, params.shadowingSigmaDb));
+      snr = std::min(snr, MAX_LINK_SNR_DB);
+      if (snr >= floorDb - LINK_MARGIN_DB) {
+        channel->setLink(a, b, snr);
+      }
+    }
+  }
+}
+
+void MeshSimulator::bootNodes() {
+  SimNode::capturePristine();
+
+  bool usedHashes[256];
+  memset(usedHashes, 0, sizeof(usedHashes));
+  for (uint16_t i = 0; i < nodeCount; ++i) {
+    nodes[i].initialize(i, params.seed, usedHashes);
+    usedHashes[nodes[i].getNodeHash()] = true;
+  }
+
+  LoRaTransmitter::registerTxCallbacks();
+  Native::RadioHal::setMedium(this);
+
+  // Identity generation consumed virtual time; traffic starts at t=0
+  Native::Hal::setMicros(0);
+}
+
+void MeshSimulator::originate(uint16_t messageIndex) {
+  MessageRecord &record = records[messageIndex];
+
+  MeshCore::DecodedPacket packet;
+  memset(&packet, 0, sizeof(packet));
+  packet.routeType = MeshCore::RouteType::FLOOD;
+  packet.payloadType = MeshCore::PayloadType::TXT_MSG;
+  packet.header = static_cast<uint8_t>(packet.routeType) |
+                  (static_cast<uint8_t>(packet.payloadType) << MeshCore::PH_TYPE_SHIFT);
+  packet.payloadLength = static_cast<uint16_t>(
+      params.payloadMin + rng.below(params.payloadMax - params.payloadMin + 1));
+  memcpy(packet.payload, &record.id, MESSAGE_ID_SIZE);
+  for (uint16_t i = MESSAGE_ID_SIZE; i < packet.payloadLength; ++i) {
+    packet.payload[i] = static_cast<uint8_t>(rng.nextU32());
+  }
+
+  uint8_t frame[Native::RadioState::MAX_FRAME_SIZE];
+  uint16_t length = MeshCore::PacketDecoder::encode(packet, frame, sizeof(frame));
+  if (length > 0) {
+    channel->begin(record.source, true, frame, static_cast<uint8_t>(length),
+                   nowMs);
+  }
+}
+
+MeshSimulator::MessageRecord *MeshSimulator::findMessage(const uint8_t *frame,
+                                                         uint8_t length) {
+  MeshCore::DecodedPacket packet;
+  if (!MeshCore::PacketDecoder::decode(frame, length, packet) ||
+      packet.payloadLength < MESSAGE_ID_SIZE) {
+    return nullptr;
+  }
+  uint32_t id;
+  memcpy(&id, packet.payload, MESSAGE_ID_SIZE);
+  if (id >= params.messages || records[id].id != id) {
+    return nullptr;
+  }
+  return &records[id];
+}
+
+void MeshSimulator::onTransmit(const uint8_t *data, uint8_t size) {
+  channel->begin(static_cast<uint16_t>(activeNode), false, data, size, nowMs);
+}
+
+void MeshSimulator::onReceive(uint16_t receiver, const Transmission &tx,
+                              float snrDb) {
+  Native::RadioHal::raiseRxDone(nodes[receiver].getRadio(), tx.frame, tx.length,
+                                VirtualChannel::rssiFromSnr(snrDb),
+                                static_cast<int8_t>(lroundf(snrDb)));
+
+  MessageRecord *record = findMessage(tx.frame, tx.length);
+  if (record != nullptr && receiver != record->source &&
+      record->firstRxMs[receiver] == NOT_RECEIVED) {
+    record->firstRxMs[receiver] = nowMs;
+    newReceivers++;
+  }
+}
+
+void MeshSimulator::onTxComplete(const Transmission &tx) {
+  if (!tx.fromClient) {
+    relayTransmissions++;
+    if (newReceivers == 0) {
+      redundantTransmissions++;
+    }
+    Native::RadioHal::raiseTxDone(nodes[tx.sender].getRadio());
+  }
+  newReceivers = 0;
+}
+
+SimulationReport MeshSimulator::run() {
+  nodes = new SimNode[nodeCount];
+  channel = new VirtualChannel(nodeCount, params.seed, params.fadingSigmaDb);
+  records = new MessageRecord[params.messages];
+
+  placeNodes();
+  buildLinks();
+  bootNodes();
+
+  for (uint16_t m = 0; m < params.messages; ++m) {
+    MessageRecord &record = records[m];
+    record.id = m;
+    record.source = static_cast<uint16_t>(rng.below(nodeCount));
+    record.originMs = m * params.intervalMs +
+                      static_cast<uint32_t>(rng.below(params.intervalMs / 2 + 1));
+    for (uint16_t n = 0; n < MAX_NODES; ++n) {
+      record.firstRxMs[n] = NOT_RECEIVED;
+    }
+  }
+
+  uint32_t lastOrigin = params.messages > 0 ? records[params.messages - 1].originMs : 0;
+  uint32_t deadline = lastOrigin + DRAIN_MS;
+  uint16_t nextMessage = 0;
+  nowMs = 0;
+
+  while (nowMs <= deadline) {
+    Native::Hal::setMicros(static_cast<uint64_t>(nowMs) * 1000);
+
+    while (nextMessage < params.messages &&
+           records[nextMessage].originMs <= nowMs) {
+      originate(nextMessage++);
+    }
+
+    channel->complete(nowMs, *this);
+
+    bool busy = false;
+    for (uint16_t i = 0; i < nodeCount; ++i) {
+      SimNode &node = nodes[i];
+      if (!node.hasPendingWork()) {
+        continue;
+      }
+      activeNode = i;
+      node.activate();
+      node.step();
+      node.deactivate();
+      activeNode = -1;
+      busy = busy || node.hasPendingWork();
+    }
+
+    uint32_t next = nowMs + 1;
+    if (!busy) {
+      // Nothing to poll: jump to the next channel or traffic event
+      uint32_t event = UINT32_MAX;
+      uint32_t completion;
+      if (channel->nextCompletion(completion)) {
+        event = completion;
+      }
+      if (nextMessage < params.messages) {
+        event = std::min(event, records[nextMessage].originMs);
+      }
+      if (event == UINT32_MAX) {
+        break;
+      }
+      next = std::max(next, event);
+    }
+    nowMs = next;
+  }
+
+  SimulationReport report;
+  fillReport(report);
+  return report;
+}
+
+void MeshSimulator::fillReport(SimulationReport &report) const {
+  memset(&report, 0, sizeof(report));
+  report.scenario = topologyName(topology);
+  report.nodes = nodeCount;
+  report.messages = params.messages;
+  report.relayTransmissions = relayTransmissions;
+  report.redundantTransmissions = redundantTransmissions;
+  report.simulatedMs = nowMs;
+  report.channel = channel->getStats();
+  for (uint16_t n = 0; n < nodeCount; ++n) {
+    addCacheStats(nodes[n].getDeduplicator().getCache(), report);
+  }
+
+  size_t capacity = static_cast<size_t>(params.messages) * nodeCount;
+  uint32_t *latencies = new uint32_t[capacity > 0 ? capacity : 1];
+  size_t count = 0;
+  uint64_t total = 0;
+  for (uint16_t m = 0; m < params.messages; ++m) {
+    const MessageRecord &record = records[m];
+    for (uint16_t n = 0; n < nodeCount; ++n) {
+      if (n == record.source) {
+        continue;
+      }
+      report.expectedDeliveries++;
+      if (record.firstRxMs[n] != NOT_RECEIVED) {
+        uint32_t latency = record.firstRxMs[n] - record.originMs;
+        latencies[count++] = latency;
+        total += latency;
+      }
+    }
+  }
+  report.deliveries = static_cast<uint32_t>(count);
+
+  if (count > 0) {
+    std::sort(latencies, latencies + count);
+    report.latencyAvgMs = static_cast<uint32_t>(total / count);
+    report.latencyP95Ms = latencies[(count * 95 + 99) / 100 - 1];
+    report.latencyMaxMs = latencies[count - 1];
+  }
+  delete[] latencies;
+}
+
+} // namespace Sim
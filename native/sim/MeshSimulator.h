@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../hal/NativeRadio.h"
+#include "SimNode.h"
+#include "SimRandom.h"
+#include "VirtualChannel.h"
+
+namespace Sim {
+
+enum class Topology : uint8_t { LINE, GRID, CLUSTER };
+
+struct SimulationParams {
+  uint64_t seed = 1;
+  uint16_t nodeCount = 0;        // 0 = topology default
+  uint16_t messages = 20;
+  uint32_t intervalMs = 10000;   // Mean spacing between originated floods
+  uint8_t payloadMin = 20;
+  uint8_t payloadMax = 60;
+
+  // Log-distance path loss; positions are in units of one "good hop"
+  float snrAtUnitDb = 4.0f;
+  float pathLossExponent = 3.5f;
+  float shadowingSigmaDb = 2.0f;  // Fixed per link
+  float fadingSigmaDb = 1.0f;     // Per frame
+};
+
+struct SimulationReport {
+  const char *scenario;
+  uint16_t nodes;
+  uint16_t messages;
+  uint32_t expectedDeliveries;   // messages * (nodes - 1)
+  uint32_t deliveries;
+  uint32_t relayTransmissions;
+  uint32_t redundantTransmissions;  // Relays that reached no new node
+  uint32_t latencyAvgMs;
+  uint32_t latencyP95Ms;
+  uint32_t latencyMaxMs;
+  uint32_t simulatedMs;
+  uint32_t dedupEvictions;       // HASH_SET: live entries displaced, all nodes
+  uint32_t dedupDecoyChecks;     // BLOOM_FILTER: decoy lookups, all nodes
+  uint32_t dedupFalsePositives;  // BLOOM_FILTER: decoy hits
+  VirtualChannel::Stats channel;
+};
+
+/**
+ * Discrete-event mesh simulation on the virtual clock.
+ *
+ * Companion devices next to random nodes originate FLOOD messages; the
+ * real repeater pipeline on every node decides what to relay. Time
+ * advances in 1 ms steps while any node has pending work and jumps to
+ * the next channel or traffic event otherwise.
+ */
+class MeshSimulator : public VirtualChannel::Listener,
+                      public Native::RadioMedium {
+public:
+  MeshSimulator(Topology topology, const SimulationParams &params);
+  ~MeshSimulator() override;
+
+  SimulationReport run();
+
+  static const char *topologyName(Topology topology);
+
+  // VirtualChannel::Listener
+  void onTxComplete(const Transmission &tx) override;
+  void onReceive(uint16_t receiver, const Transmission &tx,
+                 float snrDb) override;
+
+  // Native::RadioMedium
+  void onTransmit(const uint8_t *data, uint8_t size) override;
+
+private:
+  static constexpr uint32_t NOT_RECEIVED = UINT32_MAX;
+  static constexpr uint32_t DRAIN_MS = 60000;
+
+  struct MessageRecord {
+    uint32_t id;
+    uint16_t source;
+    uint32_t originMs;
+    uint32_t firstRxMs[MAX_NODES];
+  };
+
+  Topology topology;
+  SimulationParams params;
+  SimRandom rng;
+  uint16_t nodeCount;
+  float posX[MAX_NODES];
+  float posY[MAX_NODES];
+
+  SimNode *nodes;
+  VirtualChannel *channel;
+  MessageRecord *records;
+  uint32_t nowMs;
+  int32_t activeNode;
+  uint32_t newReceivers;
+  uint32_t relayTransmissions;
+  uint32_t redundantTransmissions;
+
+  void placeNodes();
+  void buildLinks();
+  void bootNodes();
+  void originate(uint16_t messageIndex);
+  MessageRecord *findMessage(const uint8_t *frame, uint8_t length);
+  void fillReport(SimulationReport &report) const;
+
+  MeshSimulator(const MeshSimulator &) = delete;
+  MeshSimulator &operator=(const MeshSimulator &) = delete;
+};
+
+} // namespace Sim
@@ -0,0 +1,145 @@
+#include "SimNode.h"
+
+#include <string.h>
+
+#include "../../src/core/CryptoIdentity.h"
+#include "../../src/core/NodeConfig.h"
+#include "../../src/mesh/NeighborTracker.h"
+#include "../../src/mesh/PacketDispatcher.h"
+#include "../../src/power/PowerManager.h"
+#include "../../src/radio/LoRaReceiver.h"
+#include "../../src/radio/LoRaTransmitter.h"
+#include "../../src/radio/TxScheduler.h"
+
+namespace Sim {
+
+namespace {
+
+struct Region {
+  void *address;
+  size_t size;
+};
+
+template <typename T> Region regionOf(T &instance) {
+  return Region{static_cast<void *>(&instance), sizeof(T)};
+}
+
+size_t regions(Region *out) {
+  size_t count = 0;
+  out[count++] = regionOf(LoRaTransmitter::getInstance());
+  out[count++] = regionOf(MeshCore::PacketDispatcher::getInstance());
+  out[count++] = regionOf(MeshCore::NodeConfig::getInstance());
+  out[count++] = regionOf(CryptoIdentity::getInstance());
+  out[count++] = regionOf(NeighborTracker::getInstance());
+  out[count++] = regionOf(PowerManager::getInstance());
+  out[count++] = regionOf(TxScheduler::getInstance());
+  return count;
+}
+
+constexpr size_t MAX_REGIONS = 7;
+
+FirmwareImage pristine;
+
+} // namespace
+
+const size_t FirmwareImage::SIZE =
+    sizeof(LoRaTransmitter) + sizeof(MeshCore::PacketDispatcher) +
+    sizeof(MeshCore::NodeConfig) + sizeof(CryptoIdentity) +
+    sizeof(NeighborTracker) + sizeof(PowerManager) + sizeof(TxScheduler);
+
+FirmwareImage::FirmwareImage() : bytes(new uint8_t[SIZE]) {
+  memset(bytes, 0, SIZE);
+}
+
+FirmwareImage::~FirmwareImage() { delete[] bytes; }
+
+void FirmwareImage::capture() {
+  Region list[MAX_REGIONS];
+  size_t count = regions(list);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    memcpy(bytes + offset, list[i].address, list[i].size);
+    offset += list[i].size;
+  }
+}
+
+void FirmwareImage::restore() const {
+  Region list[MAX_REGIONS];
+  size_t count = regions(list);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    memcpy(list[i].address, bytes + offset, list[i].size);
+    offset += list[i].size;
+  }
+}
+
+SimNode::SimNode()
+    : index(0), nodeHash(0), txQueued(false), prefilter(deduplicator) {}
+
+void SimNode::capturePristine() {
+  // Only the first capture sees constructor state; later simulations in
+  // the same process must not pick up the previous run's nodes
+  static bool captured = false;
+  if (!captured) {
+    pristine.capture();
+    captured = true;
+  }
+}
+
+void SimNode::initialize(uint16_t nodeIndex, uint64_t seed,
+                         const bool *usedHashes) {
+  index = nodeIndex;
+  board.chipId = 0xC0DE0000u | nodeIndex;
+
+  Native::Hal::setActiveBoard(&board);
+  Native::RadioHal::setActive(&radio);
+
+  // Fresh EEPROM makes CryptoIdentity generate a key from the board PRNG;
+  // retry with another seed until the 1-byte node hash is unique
+  for (uint32_t attempt = 0;; ++attempt) {
+    memset(board.eeprom, 0xFF, sizeof(board.eeprom));
+    board.reseed(static_cast<uint32_t>(seed * 2654435761u) ^
+                 (static_cast<uint32_t>(nodeIndex) << 16) ^ attempt);
+    pristine.restore();
+    CryptoIdentity::getInstance().initialize();
+    uint8_t hash = CryptoIdentity::getInstance().getPublicKey()[0];
+    if (hash != 0x00 && hash != 0xFF && !usedHashes[hash]) {
+      break;
+    }
+  }
+
+  MeshCore::NodeConfig::getInstance().initialize();
+  nodeHash = MeshCore::NodeConfig::getInstance().getNodeHash();
+  PowerManager::getInstance().initialize();
+
+  MeshCore::PacketDispatcher &dispatcher = MeshCore::PacketDispatcher::getInstance();
+  dispatcher.addProcessor(&deduplicator);
+  dispatcher.addProcessor(&traceHandler);
+  dispatcher.addProcessor(&forwarder);
+  deduplicator.setDuplicateListener(&forwarder);
+
+  LoRaReceiver::getInstance().setRxFilter(&prefilter);
+  LoRaReceiver::getInstance().initialize();
+  LoRaTransmitter::getInstance().initialize();
+
+  image.capture();
+}
+
+void SimNode::activate() {
+  Native::Hal::setActiveBoard(&board);
+  Native::RadioHal::setActive(&radio);
+  LoRaReceiver::getInstance().setRxFilter(&prefilter);
+  image.restore();
+}
+
+void SimNode::deactivate() { image.capture(); }
+
+void SimNode::step() {
+  Radio.IrqProcess();
+  LoRaReceiver::getInstance().processQueue();
+  forwarder.loop();
+  TxScheduler::getInstance().loop();
+  txQueued = TxScheduler::getInstance().getPendingCount() > 0;
+}
+
+} // namespace Sim
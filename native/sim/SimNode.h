@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../src/mesh/RxPrefilter.h"
+#include "../../src/mesh/processors/Deduplicator.h"
+#include "../../src/mesh/processors/PacketForwarder.h"
+#include "../../src/mesh/processors/TraceHandler.h"
+#include "../hal/NativeHal.h"
+#include "../hal/NativeRadio.h"
+
+namespace Sim {
+
+/**
+ * Byte image of the firmware singletons that hold per-node state
+ * (transmitter, TX queue, dispatcher, node config, identity, neighbours,
+ * power).
+ *
+ * The firmware is written for one node per address space, so the
+ * simulator copies each node's image in before running it and back out
+ * afterwards. The covered classes hold plain data and pointers only.
+ * LoRaReceiver is not imaged: its queue is drained within every step.
+ */
+class FirmwareImage {
+public:
+  static const size_t SIZE;
+
+  FirmwareImage();
+  ~FirmwareImage();
+
+  void capture();
+  void restore() const;
+
+private:
+  uint8_t *bytes;
+
+  FirmwareImage(const FirmwareImage &) = delete;
+  FirmwareImage &operator=(const FirmwareImage &) = delete;
+};
+
+/**
+ * One simulated repeater: its own board (EEPROM, PRNG, die id), radio,
+ * firmware image and the real Deduplicator / PacketForwarder /
+ * TraceHandler instances registered with its dispatcher.
+ */
+class SimNode {
+public:
+  SimNode();
+
+  // Boots the node; identities are regenerated until the hash is unused
+  void initialize(uint16_t index, uint64_t seed, const bool *usedHashes);
+
+  void activate();
+  void deactivate();
+  void step();
+
+  bool hasPendingWork() const {
+    return radio.pendingCount > 0 || forwarder.hasPendingPackets() || txQueued;
+  }
+
+  uint16_t getIndex() const { return index; }
+  uint8_t getNodeHash() const { return nodeHash; }
+  Native::RadioState &getRadio() { return radio; }
+  const MeshCore::PacketForwarder &getForwarder() const { return forwarder; }
+  const MeshCore::Deduplicator &getDeduplicator() const { return deduplicator; }
+
+  // Constructor-state image shared by all nodes before they boot
+  static void capturePristine();
+
+private:
+  uint16_t index;
+  uint8_t nodeHash;
+  bool txQueued;  // TxScheduler had frames waiting after the last step
+  Native::Board board;
+  Native::RadioState radio;
+  FirmwareImage image;
+
+  MeshCore::Deduplicator deduplicator;
+  MeshCore::PacketForwarder forwarder;
+  MeshCore::TraceHandler traceHandler;
+  MeshCore::RxPrefilter prefilter;
+
+  SimNode(const SimNode &) = delete;
+  SimNode &operator=(const SimNode &) = delete;
+};
+
+} // namespace Sim
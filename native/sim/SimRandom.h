@@ -0,0 +1,45 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+namespace Sim {
+
+/**
+ * Seeded xorshift64* generator. The simulator never touches wall-clock
+ * time or libc rand(), so a seed fully determines a run.
+ */
+class SimRandom {
+public:
+  explicit SimRandom(uint64_t seed) : state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull) {}
+
+  uint64_t next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1Dull;
+  }
+
+  uint32_t nextU32() { return static_cast<uint32_t>(next() >> 32); }
+
+  // Uniform in [0, bound)
+  uint32_t below(uint32_t bound) { return bound == 0 ? 0 : nextU32() % bound; }
+
+  // Uniform in [0, 1)
+  double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+  // Normal distribution (Box-Muller)
+  double gaussian(double mean, double sigma) {
+    double u1 = uniform();
+    double u2 = uniform();
+    if (u1 < 1e-12) {
+      u1 = 1e-12;
+    }
+    return mean + sigma * sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+  }
+
+private:
+  uint64_t state;
+};
+
+} // namespace Sim
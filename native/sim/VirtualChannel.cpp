@@ -0,0 +1,180 @@
+#include "VirtualChannel.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "../../src/core/Config.h"
+#include "../../src/radio/Airtime.h"
+#include "../../src/radio/LoRaTransmitter.h"
+
+namespace Sim {
+
+VirtualChannel::VirtualChannel(uint16_t nodeCount, uint64_t seed,
+                               float fadingSigmaDb)
+    : nodeCount(nodeCount), rng(seed), fadingSigmaDb(fadingSigmaDb), nextId(1) {
+  for (uint16_t a = 0; a < MAX_NODES; ++a) {
+    for (uint16_t b = 0; b < MAX_NODES; ++b) {
+      links[a][b] = NO_LINK_DB;
+    }
+  }
+  memset(slots, 0, sizeof(slots));
+  memset(&stats, 0, sizeof(stats));
+}
+
+void VirtualChannel::setLink(uint16_t a, uint16_t b, float snrDb) {
+  links[a][b] = snrDb;
+  links[b][a] = snrDb;
+}
+
+float VirtualChannel::demodulationFloorDb() {
+  // SX126x datasheet: SF7 -7.5 dB ... SF12 -20 dB, 2.5 dB per step
+  return -7.5f - 2.5f * (Config::LoRa::SPREADING_FACTOR - 7);
+}
+
+int16_t VirtualChannel::rssiFromSnr(float snrDb) {
+  // Thermal noise over the channel bandwidth plus a 6 dB noise figure;
+  // packet RSSI reports signal + noise power
+  float bw = static_cast<float>(Airtime::bandwidthHz(Config::LoRa::BANDWIDTH));
+  float noiseDbm = -174.0f + 10.0f * log10f(bw) + 6.0f;
+  float totalDbm = noiseDbm + 10.0f * log10f(1.0f + powf(10.0f, snrDb / 10.0f));
+  return static_cast<int16_t>(lroundf(totalDbm));
+}
+
+bool VirtualChannel::begin(uint16_t sender, bool fromClient,
+                           const uint8_t *frame, uint8_t length,
+                           uint32_t nowMs) {
+  prune();
+
+  Transmission *tx = nullptr;
+  for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+    if (!slots[i].inUse) {
+      tx = &slots[i];
+      break;
+    }
+  }
+  if (tx == nullptr) {
+    stats.dropped++;
+    return false;
+  }
+
+  tx->id = nextId++;
+  tx->sender = sender;
+  tx->fromClient = fromClient;
+  tx->startMs = nowMs;
+  tx->endMs = nowMs + LoRaTransmitter::estimateAirtime(length);
+  tx->length = length;
+  memcpy(tx->frame, frame, length);
+  tx->inUse = true;
+  tx->completed = false;
+
+  for (uint16_t r = 0; r < nodeCount; ++r) {
+    float base;
+    if (r == sender) {
+      base = fromClient ? CLIENT_SNR_DB : NO_LINK_DB;
+    } else {
+      base = links[sender][r];
+    }
+    tx->rxSnr[r] = (base <= NO_LINK_DB)
+                       ? NO_LINK_DB
+                       : static_cast<float>(rng.gaussian(base, fadingSigmaDb));
+  }
+
+  stats.transmissions++;
+  return true;
+}
+
+bool VirtualChannel::nextCompletion(uint32_t &timeMs) const {
+  bool found = false;
+  for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+    const Transmission &tx = slots[i];
+    if (tx.inUse && !tx.completed && (!found || tx.endMs < timeMs)) {
+      timeMs = tx.endMs;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void VirtualChannel::complete(uint32_t nowMs, Listener &listener) {
+  // Finish in start order so results do not depend on slot layout
+  while (true) {
+    Transmission *next = nullptr;
+    for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+      Transmission &tx = slots[i];
+      if (tx.inUse && !tx.completed && tx.endMs <= nowMs &&
+          (next == nullptr || tx.id < next->id)) {
+        next = &tx;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+    finish(*next, listener);
+  }
+}
+
+void VirtualChannel::finish(Transmission &tx, Listener &listener) {
+  tx.completed = true;
+
+  for (uint16_t r = 0; r < nodeCount; ++r) {
+    if (tx.rxSnr[r] <= NO_LINK_DB) {
+      continue;
+    }
+    if (tx.rxSnr[r] < demodulationFloorDb()) {
+      stats.belowSensitivity++;
+      continue;
+    }
+    if (!receptionSurvives(tx, r)) {
+      continue;
+    }
+    stats.receptions++;
+    listener.onReceive(r, tx, tx.rxSnr[r]);
+  }
+
+  listener.onTxComplete(tx);
+}
+
+bool VirtualChannel::receptionSurvives(const Transmission &tx,
+                                       uint16_t receiver) {
+  for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+    const Transmission &other = slots[i];
+    if (!other.inUse || other.id == tx.id) {
+      continue;
+    }
+    if (other.startMs >= tx.endMs || other.endMs <= tx.startMs) {
+      continue;
+    }
+
+    if (other.sender == receiver && !other.fromClient) {
+      stats.halfDuplexLosses++;
+      return false;
+    }
+
+    float interference = other.rxSnr[receiver];
+    if (interference > NO_LINK_DB &&
+        interference + CAPTURE_DB > tx.rxSnr[receiver]) {
+      stats.collisions++;
+      return false;
+    }
+  }
+  return true;
+}
+
+void VirtualChannel::prune() {
+  // A finished frame is only needed while something it overlapped is airborne
+  uint32_t oldestActiveStart = UINT32_MAX;
+  for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+    if (slots[i].inUse && !slots[i].completed &&
+        slots[i].startMs < oldestActiveStart) {
+      oldestActiveStart = slots[i].startMs;
+    }
+  }
+  for (size_t i = 0; i < MAX_TRANSMISSIONS; ++i) {
+    if (slots[i].inUse && slots[i].completed &&
+        slots[i].endMs <= oldestActiveStart) {
+      slots[i].inUse = false;
+    }
+  }
+}
+
+} // namespace Sim
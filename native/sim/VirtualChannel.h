@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SimRandom.h"
+
+namespace Sim {
+
+constexpr uint16_t MAX_NODES = 64;
+constexpr float NO_LINK_DB = -1000.0f;
+
+/**
+ * One frame on the air. Per-receiver SNR is sampled (link SNR plus
+ * fading) when the transmission starts, so collision checks compare
+ * the same values the receivers would have seen.
+ */
+struct Transmission {
+  uint32_t id;
+  uint16_t sender;
+  bool fromClient;  // Sent by a companion device co-located with sender
+  uint32_t startMs;
+  uint32_t endMs;
+  uint8_t length;
+  uint8_t frame[255];
+  float rxSnr[MAX_NODES];
+  bool inUse;
+  bool completed;
+};
+
+/**
+ * Shared half-duplex LoRa channel between simulated nodes.
+ *
+ * Airtime comes from LoRaTransmitter::estimateAirtime. A reception
+ * succeeds when the sampled SNR clears the spreading factor's
+ * demodulation floor, the receiver was not transmitting, and every
+ * overlapping frame is at least CAPTURE_DB weaker at that receiver.
+ */
+class VirtualChannel {
+public:
+  static constexpr float CAPTURE_DB = 6.0f;
+  static constexpr float CLIENT_SNR_DB = 10.0f;
+  static constexpr size_t MAX_TRANSMISSIONS = 64;
+
+  struct Stats {
+    uint32_t transmissions;
+    uint32_t receptions;
+    uint32_t collisions;
+    uint32_t halfDuplexLosses;
+    uint32_t belowSensitivity;
+    uint32_t dropped;  // No free transmission slot
+  };
+
+  // Receptions of a frame are reported before its onTxComplete()
+  class Listener {
+  public:
+    virtual ~Listener() = default;
+    virtual void onTxComplete(const Transmission &tx) = 0;
+    virtual void onReceive(uint16_t receiver, const Transmission &tx,
+                           float snrDb) = 0;
+  };
+
+  VirtualChannel(uint16_t nodeCount, uint64_t seed, float fadingSigmaDb);
+
+  void setLink(uint16_t a, uint16_t b, float snrDb);
+  float getLink(uint16_t a, uint16_t b) const { return links[a][b]; }
+
+  bool begin(uint16_t sender, bool fromClient, const uint8_t *frame,
+             uint8_t length, uint32_t nowMs);
+  void complete(uint32_t nowMs, Listener &listener);
+  bool nextCompletion(uint32_t &timeMs) const;
+
+  const Stats &getStats() const { return stats; }
+
+  static float demodulationFloorDb();
+  static int16_t rssiFromSnr(float snrDb);
+
+private:
+  uint16_t nodeCount;
+  SimRandom rng;
+  float fadingSigmaDb;
+  float links[MAX_NODES][MAX_NODES];
+  Transmission slots[MAX_TRANSMISSIONS];
+  uint32_t nextId;
+  Stats stats;
+
+  void finish(Transmission &tx, Listener &listener);
+  bool receptionSurvives(const Transmission &tx, uint16_t receiver);
+  void prune();
+};
+
+} // namespace Sim
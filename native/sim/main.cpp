@@ -0,0 +1,133 @@
+// Deterministic multi-node mesh simulator.
+//
+// Runs N copies of the repeater pipeline (Deduplicator, TraceHandler,
+// PacketForwarder) against a shared virtual LoRa channel and reports
+// delivery, relay count, latency and seen-packet cache pressure (hash set
+// evictions, Bloom filter false positives) per topology. The same seed always
+// produces the same output, so forwarding changes can be compared
+// before and after.
+//
+// Options:
+//   --seed <n>          PRNG seed (default 1)
+//   --scenario <name>   line | grid | cluster | all (default all)
+//   --nodes <n>         node count override (max 64)
+//   --messages <n>      flood messages per scenario (default 20)
+//   --interval <ms>     mean spacing between messages (default 10000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/core/Config.h"
+#include "MeshSimulator.h"
+
+namespace {
+
+void printHeader(const Sim::SimulationParams &params) {
+  printf("# mesh_sim seed=%llu messages=%u interval=%ums\n",
+         static_cast<unsigned long long>(params.seed), params.messages,
+         params.intervalMs);
+  printf("# SF%u BW=%u RX_DELAY_BASE=%.2f RX_DELAY_SHAPE=%u TX_DELAY_FACTOR=%.2f "
+         "TX_DELAY_JITTER_SLOTS=%u\n",
+         Config::LoRa::SPREADING_FACTOR, Config::LoRa::BANDWIDTH,
+         static_cast<double>(Config::Forwarding::RX_DELAY_BASE),
+         static_cast<unsigned>(Config::Forwarding::RX_DELAY_SHAPE),
+         static_cast<double>(Config::Forwarding::TX_DELAY_FACTOR),
+         Config::Forwarding::TX_DELAY_JITTER_SLOTS);
+  printf("%-8s %5s %9s %7s %6s %9s %7s %7s %7s %6s %6s %6s %7s\n", "scenario",
+         "nodes", "delivered", "ratio", "relays", "redundant", "avg_ms",
+         "p95_ms", "max_ms", "collis", "hdx", "evict", "fp_pct");
+}
+
+void printReport(const Sim::SimulationReport &r) {
+  double ratio = r.expectedDeliveries > 0
+                     ? static_cast<double>(r.deliveries) / r.expectedDeliveries
+                     : 0.0;
+  printf("%-8s %5u %4u/%-4u %7.3f %6u %9u %7u %7u %7u %6u %6u %6u ", r.scenario,
+         r.nodes, r.deliveries, r.expectedDeliveries, ratio,
+         r.relayTransmissions, r.redundantTransmissions, r.latencyAvgMs,
+         r.latencyP95Ms, r.latencyMaxMs, r.channel.collisions,
+         r.channel.halfDuplexLosses, r.dedupEvictions);
+  // Measured Bloom filter false positives; the hash set has none
+  if (r.dedupDecoyChecks > 0) {
+    printf("%7.2f\n", 100.0 * r.dedupFalsePositives / r.dedupDecoyChecks);
+  } else {
+    printf("%7s\n", "-");
+  }
+}
+
+bool parseTopology(const char *name, Sim::Topology &out) {
+  if (strcmp(name, "line") == 0) {
+    out = Sim::Topology::LINE;
+  } else if (strcmp(name, "grid") == 0) {
+    out = Sim::Topology::GRID;
+  } else if (strcmp(name, "cluster") == 0) {
+    out = Sim::Topology::CLUSTER;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--seed n] [--scenario line|grid|cluster|all] "
+          "[--nodes n] [--messages n] [--interval ms]\n",
+          argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Sim::SimulationParams params;
+  const char *scenario = "all";
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (value == nullptr) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (strcmp(arg, "--seed") == 0) {
+      params.seed = strtoull(value, nullptr, 0);
+    } else if (strcmp(arg, "--scenario") == 0) {
+      scenario = value;
+    } else if (strcmp(arg, "--nodes") == 0) {
+      params.nodeCount = static_cast<uint16_t>(atoi(value));
+    } else if (strcmp(arg, "--messages") == 0) {
+      params.messages = static_cast<uint16_t>(atoi(value));
+    } else if (strcmp(arg, "--interval") == 0) {
+      params.intervalMs = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+    ++i;
+  }
+
+  static const Sim::Topology all[] = {Sim::Topology::LINE, Sim::Topology::GRID,
+                                      Sim::Topology::CLUSTER};
+  Sim::Topology selected[3];
+  size_t selectedCount = 0;
+  if (strcmp(scenario, "all") == 0) {
+    for (size_t i = 0; i < 3; ++i) {
+      selected[selectedCount++] = all[i];
+    }
+  } else if (parseTopology(scenario, selected[0])) {
+    selectedCount = 1;
+  } else {
+    usage(argv[0]);
+    return 2;
+  }
+
+  printHeader(params);
+  // Nodes boot from the pristine singleton image, so scenarios are independent
+  for (size_t i = 0; i < selectedCount; ++i) {
+    Sim::MeshSimulator *sim = new Sim::MeshSimulator(selected[i], params);
+    Sim::SimulationReport report = sim->run();
+    printReport(report);
+    delete sim;
+  }
+  return 0;
+}
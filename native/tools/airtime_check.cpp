@@ -0,0 +1,94 @@
+// Host check for src/radio/Airtime.h.
+//
+// Compares the compile-time integer time-on-air against a floating-point
+// transcription of the SX1261/2 datasheet formula for every spreading
+// factor, bandwidth, coding rate, header/CRC mode and frame length, and
+// against published reference airtimes. Prints the configured radio's
+// table summary. Exit status is non-zero on any mismatch.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "../../src/radio/Airtime.h"
+#include "../../src/radio/LoRaTransmitter.h"
+
+namespace {
+
+double datasheetUs(uint16_t length, uint8_t sf, double bwHz, uint8_t cr,
+                   uint16_t preamble, bool crc, bool implicitHeader) {
+  double tsym = pow(2.0, sf) / bwHz * 1e6;
+  bool ldro = tsym >= 16000.0;
+  double numerator = 8.0 * length - 4.0 * sf + (sf < 7 ? 0 : 8) +
+                     (crc ? 16 : 0) + (implicitHeader ? 0 : 20);
+  double symbols = 8 + ceil(fmax(numerator, 0.0) / (4.0 * (sf - (ldro ? 2 : 0)))) * (cr + 4);
+  double preambleSymbols = preamble + (sf < 7 ? 6.25 : 4.25);
+  return (preambleSymbols + symbols) * tsym;
+}
+
+struct Reference {
+  uint16_t length;
+  uint8_t sf;
+  uint32_t bwHz;
+  uint8_t cr;
+  uint16_t preamble;
+  double ms;
+};
+
+// Semtech LoRa calculator, explicit header, CRC on
+const Reference REFERENCES[] = {
+  {13, 7, 125000, 1, 8, 46.336},
+  {13, 12, 125000, 1, 8, 1155.072},
+  {51, 7, 125000, 1, 8, 102.656},
+  {51, 10, 125000, 1, 8, 616.448},
+  {222, 7, 250000, 1, 8, 174.208},
+};
+
+} // namespace
+
+int main() {
+  uint32_t checked = 0;
+  uint32_t failures = 0;
+
+  for (uint8_t sf = 5; sf <= 12; ++sf) {
+    for (uint8_t bwIndex = 0; bwIndex <= 9; ++bwIndex) {
+      uint32_t bwHz = Airtime::bandwidthHz(bwIndex);
+      for (uint8_t cr = 1; cr <= 4; ++cr) {
+        for (int mode = 0; mode < 4; ++mode) {
+          bool crc = (mode & 1) != 0;
+          bool implicitHeader = (mode & 2) != 0;
+          for (uint16_t length = 0; length <= Airtime::MAX_LENGTH; ++length) {
+            uint32_t actual = Airtime::timeOnAirUs(length, sf, bwHz, cr, 8, crc,
+                                                   implicitHeader);
+            double expected = datasheetUs(length, sf, bwHz, cr, 8, crc, implicitHeader);
+            checked++;
+            if (fabs(actual - expected) > 1.0) {
+              if (failures++ < 10) {
+                printf("MISMATCH SF%u BW%u CR4/%u crc=%d ih=%d len=%u: %u us, expected %.1f us\n",
+                       sf, bwHz, cr + 4, crc, implicitHeader, length, actual, expected);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (const Reference &ref : REFERENCES) {
+    uint32_t actual = Airtime::timeOnAirUs(ref.length, ref.sf, ref.bwHz, ref.cr,
+                                           ref.preamble, true, false);
+    checked++;
+    if (fabs(actual / 1000.0 - ref.ms) > 0.001) {
+      failures++;
+      printf("REFERENCE SF%u BW%u len=%u: %.3f ms, expected %.3f ms\n", ref.sf,
+             ref.bwHz, ref.length, actual / 1000.0, ref.ms);
+    }
+  }
+
+  printf("Configured SF%u BW%u CR4/%u preamble %u: 1 B %u ms, 64 B %u ms, 255 B %u ms\n",
+         Config::LoRa::SPREADING_FACTOR, Airtime::bandwidthHz(Config::LoRa::BANDWIDTH),
+         Config::LoRa::CODING_RATE + 4, Config::LoRa::PREAMBLE_LENGTH,
+         LoRaTransmitter::estimateAirtime(1), LoRaTransmitter::estimateAirtime(64),
+         LoRaTransmitter::estimateAirtime(255));
+  printf("%u combinations checked, %u failures\n", checked, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -10,6 +10,9 @@ namespace Config {
 
 namespace Power {
 constexpr bool LIGHT_SLEEP_ENABLED = true;
+// Scheduled transmissions closer than this are polled instead of armed
+// as an RTC wakeup
+constexpr uint32_t MIN_TIMED_SLEEP_MS = 2;
 // Note: VEXT control is handled automatically by CubeCell framework
 // No manual control is needed for HTCC-AB02A
 } // namespace Power
@@ -21,7 +24,8 @@ constexpr uint8_t SPREADING_FACTOR = 8;
 constexpr uint8_t CODING_RATE = 4;
 constexpr uint8_t PREAMBLE_LENGTH = 16;
 constexpr uint8_t SYNC_WORD = 0x12;
-constexpr bool FIXED_LENGTH_PAYLOAD = false;
+constexpr bool FIXED_LENGTH_PAYLOAD = false;  // false = explicit header
+constexpr bool CRC_ENABLED = true;
 constexpr bool IQ_INVERSION = false;
 constexpr uint8_t TX_POWER = 22;  // Maximum power for SX1262
 constexpr uint32_t TX_TIMEOUT_MS = 3000;
@@ -29,32 +33,87 @@ constexpr uint32_t TX_TIMEOUT_MS = 3000;
 
 namespace Logging {
 constexpr size_t BUFFER_SIZE = 128;  // Reduced from 256 to save stack space
+
+// Builds with -DENABLE_PROFILING print the pipeline profile this often
+// (0 = only on !perf)
+constexpr uint32_t PROFILE_REPORT_INTERVAL_MS = 300000;
 }
 
 namespace Dispatcher {
 constexpr size_t MAX_PROCESSORS = 8;
+
+// true: main.cpp runs the processors as a StaticPipeline (sorted at
+// compile time, no virtual calls) instead of registering them
+constexpr bool STATIC_PIPELINE = false;
 }
 
 namespace Deduplication {
-constexpr size_t CACHE_SIZE = 16;
+// HASH_SET is exact. BLOOM_FILTER remembers thousands of packets in the
+// same RAM at the cost of occasional false duplicates.
+enum class Backend : uint8_t { HASH_SET, BLOOM_FILTER };
+constexpr Backend BACKEND = Backend::HASH_SET;
+
 constexpr uint32_t CACHE_TIMEOUT_MS = 60000;
+constexpr size_t CACHE_SIZE = 128;  // HASH_SET: power of two, 8 bytes per entry
+
+// BLOOM_FILTER: two generations of CACHE_TIMEOUT_MS / 2 each (1 KB total).
+// The filter measures its own false positives; mesh_sim reports them
+// (fp_pct) when this backend is selected, and HASH_SET evictions (evict).
+constexpr size_t BLOOM_FILTER_BITS = 4096;  // Per generation, power of two
+constexpr uint8_t BLOOM_FILTER_HASHES = 4;
 } // namespace Deduplication
 
 namespace Queue {
-constexpr size_t PACKET_QUEUE_SIZE = 16;
+// RX queue of raw frames in a shared arena, dequeued by traffic class.
+// Holds 48 typical 40-byte frames or 9 maximum-size ones; slot metadata
+// keeps the total near 3 KB.
+constexpr size_t PACKET_QUEUE_SLOTS = 48;
+constexpr size_t PACKET_QUEUE_BUFFER_SIZE = 2304;
+constexpr size_t MAX_FRAME_SIZE = 255;
+
+// Reject frames in the RX callback, before they take a queue slot
+constexpr bool PREFILTER_DUPLICATES = true;   // Already in the dedup cache
+constexpr bool PREFILTER_NOT_FOR_US = true;   // DIRECT with another next hop
 }
 
+namespace Tx {
+// Shared pool of encoded frames waiting for the transmitter. Writers
+// reserve MAX_ENCODED_PACKET_SIZE bytes while building a frame.
+constexpr size_t QUEUE_SLOTS = 8;
+constexpr size_t QUEUE_BUFFER_SIZE = 768;
+
+// A frame the duty cycle refuses is retried after slot << (attempt - 1)
+// plus up to one slot of jitter (slot = airtime * TX_DELAY_FACTOR). It is
+// dropped after RETRY_MAX_ATTEMPTS refusals, or once it has waited
+// MAX_FRAME_AGE_MS since it was queued.
+constexpr uint8_t RETRY_MAX_ATTEMPTS = 6;
+constexpr uint32_t MAX_FRAME_AGE_MS = 30000;
+} // namespace Tx
+
 namespace Channels {
 // Private channel keys (hex format, 32 characters = 16 bytes)
-// Add your private channel keys here
+// Add your private channel keys here (up to 128, 18 bytes of RAM each)
 constexpr const char* PRIVATE_CHANNEL_KEYS[] = {
   "b4a28381f505eb67e696ed3d2294c81f",
   // Add more private channels here as needed
   // "1234567890abcdef1234567890abcdef",
 };
 constexpr size_t NUM_PRIVATE_CHANNELS = sizeof(PRIVATE_CHANNEL_KEYS) / sizeof(PRIVATE_CHANNEL_KEYS[0]);
+
+// Expanded AES and HMAC state is kept for this many recently used
+// channels (about 250 bytes each, 420 with Crypto::AES_TTABLES); other
+// channels are expanded from their secret on a cache miss
+constexpr size_t KEY_CACHE_SIZE = 4;
 } // namespace Channels
 
+namespace Crypto {
+// true: channel keys use the 32-bit T-table AES (about 2 KB more flash and
+// 176 more bytes of RAM per Channels::KEY_CACHE_SIZE entry, several times
+// fewer cycles per block) instead of the byte-oriented reference. Off by
+// default to leave the SRAM to the queues.
+constexpr bool AES_TTABLES = false;
+} // namespace Crypto
+
 namespace Identity {
 // Node name prefix (appears before the node hash in status messages)
 constexpr const char* NODE_NAME = "VieZe Rogue";
@@ -81,12 +140,14 @@ constexpr int16_t MIN_RSSI_TO_FORWARD = -120;
 
 // Delay calculation parameters - tune these for latency vs collision tradeoff
 constexpr float RX_DELAY_BASE = 2.5f;           // Base for exponential backoff
+
+// Shape of the SNR -> RX delay curve (see mesh/RxDelayCurve.h). All are
+// built from RX_DELAY_BASE at compile time.
+enum class RxDelayShape : uint8_t { EXPONENTIAL, LINEAR, STEPPED };
+constexpr RxDelayShape RX_DELAY_SHAPE = RxDelayShape::EXPONENTIAL;
+constexpr uint8_t RX_DELAY_STEPS = 10;          // STEPPED: score buckets
 constexpr float TX_DELAY_FACTOR = 2.0f;         // Jitter slot size multiplier
 
-// WARNING: Duty cycle enforcement is currently disabled. Users MUST ensure
-// compliance with local regulations (e.g., EU 868MHz requires 1% duty cycle).
-// Consider implementing duty cycle tracking for production deployments.
-constexpr bool DUTY_CYCLE_ENABLED = false;
 constexpr uint32_t MIN_DELAY_THRESHOLD_MS = 20; // Reduced from 50ms for lower latency
 constexpr uint8_t TX_DELAY_JITTER_SLOTS = 6;    // Random jitter slots (0-5)
 
@@ -95,11 +156,62 @@ constexpr float SNR_SCALE_FACTOR = 4.0f;  // LoRa reports SNR in 0.25 dB units
 constexpr float SNR_MIN_DB = -20.0f;      // Minimum expected SNR in dB
 constexpr float SNR_RANGE_DB = 40.0f;     // Expected SNR range (from -20 to +20 dB)
 
-// Delayed forwarding queue
-constexpr size_t DELAY_QUEUE_SIZE = 4;
+// Delayed forwarding queue: up to DELAY_QUEUE_SIZE frames sharing a
+// DELAY_QUEUE_BUFFER_SIZE byte arena (~25 typical or 6 maximum-size frames)
+constexpr size_t DELAY_QUEUE_SIZE = 32;
+constexpr size_t DELAY_QUEUE_BUFFER_SIZE = 1536;
+
+// Delay queue slots kept for each traffic class (HIGH, MEDIUM, LOW, see
+// mesh/TrafficClass.h); the rest are shared. When the queue is full a
+// higher class evicts the lowest-class entry with the furthest deadline,
+// and a class below its reserve may evict any class above its own.
+constexpr uint8_t DELAY_QUEUE_RESERVED_SLOTS[] = {4, 4, 2};
+
+// Duplicate suppression: cancel a queued FLOOD forward once this many
+// neighbours have been heard relaying it (0 disables suppression).
+// Copies below the threshold push the forward back by one jitter slot.
+constexpr uint8_t DUPLICATE_CANCEL_THRESHOLD = 1;
+
+// A queued forward is dropped once it has waited MAX_FORWARD_AGE_MS
+// without being handed to the TxScheduler (see Tx::RETRY_MAX_ATTEMPTS for
+// what happens after that)
+constexpr uint32_t MAX_FORWARD_AGE_MS = 30000;
 
 // Buffer sizes
 constexpr size_t MAX_ENCODED_PACKET_SIZE = 256;
 } // namespace Forwarding
 
+namespace DutyCycle {
+// Enforce the regulatory duty cycle of the sub-band containing
+// LoRa::FREQUENCY. Airtime is always tracked; this only controls blocking.
+constexpr bool ENABLED = true;
+
+struct SubBand {
+  uint32_t minHz;
+  uint32_t maxHz;
+  uint16_t limitPermille;
+};
+
+// ETSI EN 300 220 (EU868) sub-bands
+constexpr SubBand SUB_BANDS[] = {
+  {863000000, 868000000, 10},   // 1%
+  {868000000, 868600000, 10},   // g1: 1%
+  {868700000, 869200000, 1},    // g2: 0.1%
+  {869400000, 869650000, 100},  // g3: 10%
+  {869700000, 870000000, 10},   // g4: 1%
+};
+constexpr uint16_t DEFAULT_LIMIT_PERMILLE = 10;  // Outside the table
+
+// Sliding 1 h window in 1 min buckets
+constexpr uint32_t WINDOW_MS = 3600000;
+constexpr uint8_t BUCKET_COUNT = 60;
+
+// Token bucket smoothing bursts within the hour (capped at the hourly budget)
+constexpr uint32_t BURST_MS = 10000;
+
+// Share of both budgets that only TrafficClass::HIGH frames (DIRECT,
+// ACK, PATH, TRACE) may use
+constexpr uint8_t HIGH_PRIORITY_RESERVE_PERCENT = 25;
+} // namespace DutyCycle
+
 } // namespace Config
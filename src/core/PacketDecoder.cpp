@@ -5,6 +5,36 @@
 
 namespace MeshCore {
 
+bool PacketDecoder::parseLayout(const uint8_t *raw, uint16_t length,
+                                FrameLayout &layout) {
+  if (length < MIN_PACKET_SIZE)
+    return false;
+
+  uint8_t header = raw[0];
+  layout.routeType = static_cast<RouteType>(header & PH_ROUTE_MASK);
+  layout.payloadType =
+      static_cast<PayloadType>((header >> PH_TYPE_SHIFT) & PH_TYPE_MASK);
+  layout.payloadVersion = (header >> PH_VER_SHIFT) & PH_VER_MASK;
+
+  bool hasTransportCodes = (layout.routeType == RouteType::TRANSPORT_FLOOD ||
+                            layout.routeType == RouteType::TRANSPORT_DIRECT);
+  uint16_t idx = hasTransportCodes ? 1 + TRANSPORT_CODES_TOTAL_SIZE : 1;
+  if (idx >= length)
+    return false;
+  layout.pathLengthIndex = static_cast<uint8_t>(idx);
+  layout.pathLength = raw[idx++];
+
+  if (layout.pathLength > MAX_PATH_SIZE)
+    return false;
+  if (idx + layout.pathLength > length)
+    return false;
+  idx += layout.pathLength;
+
+  layout.payloadOffset = idx;
+  layout.payloadLength = length - idx;
+  return layout.payloadLength <= MAX_PACKET_PAYLOAD;
+}
+
 bool PacketDecoder::decode(const uint8_t *raw, uint16_t length,
                            DecodedPacket &packet) {
   if (length < MIN_PACKET_SIZE)
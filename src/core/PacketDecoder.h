@@ -93,8 +93,24 @@ struct DecodedPacket {
   uint16_t advertFeat2;
 };
 
+/**
+ * Field positions within a raw frame, found without copying anything.
+ */
+struct FrameLayout {
+  RouteType routeType;
+  PayloadType payloadType;
+  uint8_t payloadVersion;
+  uint8_t pathLengthIndex;  // Offset of the path length byte
+  uint8_t pathLength;
+  uint16_t payloadOffset;
+  uint16_t payloadLength;
+};
+
 class PacketDecoder {
 public:
+  // Same bounds checks as decode(), for callers that only need offsets
+  static bool parseLayout(const uint8_t *raw, uint16_t length,
+                          FrameLayout &layout);
   static bool decode(const uint8_t *raw, uint16_t length,
                      DecodedPacket &packet);
   static uint16_t encode(const DecodedPacket &packet, uint8_t *raw,
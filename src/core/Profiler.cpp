@@ -0,0 +1,113 @@
+#include "Profiler.h"
+
+#ifdef ENABLE_PROFILING
+
+#include "Logger.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+const char *const SECTION_NAMES[Profiler::SECTION_COUNT] = {"RxCallback",
+                                                            "RxDecode",
+                                                            "QueueDrain"};
+
+// Capitals of a CamelCase name: "PacketForwarder" -> "PF"
+void abbreviate(const char *name, char *out, size_t size) {
+  size_t length = 0;
+  for (const char *c = name; *c != '\0' && length + 1 < size; ++c) {
+    if (*c >= 'A' && *c <= 'Z') {
+      out[length++] = *c;
+    }
+  }
+  out[length] = '\0';
+}
+}
+
+Profiler &Profiler::getInstance() {
+  static Profiler instance;
+  return instance;
+}
+
+void Profiler::record(StageStats &stats, uint32_t elapsedUs) {
+  stats.calls++;
+  stats.totalUs += elapsedUs;
+  if (elapsedUs < stats.minUs) {
+    stats.minUs = elapsedUs;
+  }
+  if (elapsedUs > stats.maxUs) {
+    stats.maxUs = elapsedUs;
+  }
+}
+
+void Profiler::recordStage(uint8_t index, const char *name, uint8_t outcome,
+                           uint32_t elapsedUs) {
+  if (index >= MAX_STAGES || outcome >= 3) {
+    return;
+  }
+  StageStats &stats = stages[index];
+  if (stats.name != name) {
+    // Processor set changed, the slot now belongs to someone else
+    memset(&stats, 0, sizeof(stats));
+    stats.name = name;
+    stats.minUs = UINT32_MAX;
+  }
+  record(stats, elapsedUs);
+  stats.outcomes[outcome]++;
+}
+
+void Profiler::recordSection(Section section, uint32_t elapsedUs) {
+  record(sections[section], elapsedUs);
+}
+
+size_t Profiler::formatSummary(char *buffer, size_t size) const {
+  size_t used = 0;
+  buffer[0] = '\0';
+
+  // Abbreviated names keep all stages within one channel message
+  for (size_t i = 0; i < SECTION_COUNT + MAX_STAGES && used < size; ++i) {
+    const StageStats &stats =
+        i < SECTION_COUNT ? sections[i] : stages[i - SECTION_COUNT];
+    if (stats.calls == 0) {
+      continue;
+    }
+    char shortName[4];
+    abbreviate(stats.name, shortName, sizeof(shortName));
+    int written = snprintf(buffer + used, size - used, "%s%s:%lu/%lu",
+                           used > 0 ? " " : "", shortName, stats.averageUs(),
+                           stats.maxUs);
+    if (written < 0) {
+      break;
+    }
+    used += static_cast<size_t>(written);
+  }
+  return used < size ? used : size - 1;
+}
+
+void Profiler::logReport() const {
+  LOG_INFO("Profile: name calls cont/stop/drop min/avg/max us");
+  for (size_t i = 0; i < SECTION_COUNT + MAX_STAGES; ++i) {
+    const StageStats &stats =
+        i < SECTION_COUNT ? sections[i] : stages[i - SECTION_COUNT];
+    if (stats.calls == 0) {
+      continue;
+    }
+    LOG_INFO_FMT("  %-18s %6lu %lu/%lu/%lu %lu/%lu/%lu", stats.name,
+                 stats.calls, stats.outcomes[0], stats.outcomes[1],
+                 stats.outcomes[2], stats.minUs, stats.averageUs(),
+                 stats.maxUs);
+  }
+}
+
+void Profiler::reset() {
+  memset(stages, 0, sizeof(stages));
+  memset(sections, 0, sizeof(sections));
+  for (size_t i = 0; i < MAX_STAGES; ++i) {
+    stages[i].minUs = UINT32_MAX;
+  }
+  for (size_t i = 0; i < SECTION_COUNT; ++i) {
+    sections[i].name = SECTION_NAMES[i];
+    sections[i].minUs = UINT32_MAX;
+  }
+}
+
+#endif
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Config.h"
+#include <Arduino.h>
+
+/**
+ * Pipeline profiler: call counts, outcomes and micros() cost per packet
+ * processor, plus the radio receive sections.
+ *
+ * Built only with -DENABLE_PROFILING (the debug env). Otherwise the
+ * PROFILE_* macros expand to nothing and none of this is compiled.
+ */
+#ifdef ENABLE_PROFILING
+
+struct StageStats {
+  const char *name;
+  uint32_t calls;
+  uint32_t outcomes[3];  // CONTINUE, STOP, DROP
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint32_t totalUs;
+
+  uint32_t averageUs() const { return calls > 0 ? totalUs / calls : 0; }
+};
+
+class Profiler {
+public:
+  enum Section : uint8_t {
+    RX_CALLBACK,  // LoRaReceiver::onRxDone, raw validation and enqueue
+    RX_DECODE,    // Decode and validation of one queued frame
+    QUEUE_DRAIN,  // One LoRaReceiver::processQueue pass, dispatch included
+    SECTION_COUNT
+  };
+
+  static Profiler &getInstance();
+
+  // Stage index is the processor's position in the dispatch order
+  void recordStage(uint8_t index, const char *name, uint8_t outcome,
+                   uint32_t elapsedUs);
+  void recordSection(Section section, uint32_t elapsedUs);
+
+  // One-line summary (avg/max us per stage) for the !perf response
+  size_t formatSummary(char *buffer, size_t size) const;
+
+  // Full table over serial
+  void logReport() const;
+
+  void reset();
+
+private:
+  Profiler() { reset(); }
+
+  static constexpr size_t MAX_STAGES = Config::Dispatcher::MAX_PROCESSORS;
+
+  StageStats stages[MAX_STAGES];
+  StageStats sections[SECTION_COUNT];
+
+  static void record(StageStats &stats, uint32_t elapsedUs);
+
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+};
+
+#define PROFILE_START(var) uint32_t var = micros()
+#define PROFILE_STAGE(index, name, outcome, start)                             \
+  Profiler::getInstance().recordStage(index, name,                             \
+                                      static_cast<uint8_t>(outcome),           \
+                                      micros() - (start))
+#define PROFILE_SECTION(section, start)                                        \
+  Profiler::getInstance().recordSection(Profiler::section, micros() - (start))
+#else
+#define PROFILE_START(var) ((void)0)
+#define PROFILE_STAGE(index, name, outcome, start) ((void)0)
+#define PROFILE_SECTION(section, start) ((void)0)
+#endif
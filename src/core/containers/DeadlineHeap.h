@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace MeshCore {
+
+/**
+ * Binary min-heap of (deadline, slot) pairs, earliest deadline first.
+ * Optimized for embedded systems with no dynamic allocation.
+ *
+ * Items are small slot indices into separate storage (e.g. FrameSlab),
+ * so push/pop only move 8-byte entries. Deadlines are millis() values
+ * compared with wraparound.
+ *
+ * @tparam SIZE Maximum number of entries
+ */
+template <size_t SIZE> class DeadlineHeap {
+public:
+  DeadlineHeap() : count(0) {}
+
+  /**
+   * Add a slot with its deadline
+   *
+   * @return false if the heap is full
+   */
+  bool push(uint32_t deadline, uint8_t slot) {
+    if (count >= SIZE) {
+      return false;
+    }
+    entries[count].deadline = deadline;
+    entries[count].slot = slot;
+    siftUp(count);
+    count++;
+    return true;
+  }
+
+  /**
+   * Earliest entry without removing it
+   */
+  bool peek(uint32_t &deadline, uint8_t &slot) const {
+    if (count == 0) {
+      return false;
+    }
+    deadline = entries[0].deadline;
+    slot = entries[0].slot;
+    return true;
+  }
+
+  /**
+   * Remove the earliest entry
+   */
+  bool pop() { return count > 0 && removeAt(0); }
+
+  /**
+   * Remove the entry for a slot
+   */
+  bool remove(uint8_t slot) {
+    size_t index;
+    return find(slot, index) && removeAt(index);
+  }
+
+  /**
+   * Move a slot to a new deadline, earlier or later
+   */
+  bool reschedule(uint8_t slot, uint32_t deadline) {
+    size_t index;
+    if (!find(slot, index)) {
+      return false;
+    }
+    entries[index].deadline = deadline;
+    siftUp(index);
+    siftDown(index);
+    return true;
+  }
+
+  /**
+   * Visit entries in heap (not deadline) order
+   *
+   * @param fn Function called for each entry: bool fn(uint32_t deadline, uint8_t slot)
+   *           Return false to stop iteration early
+   */
+  template <typename Func> void forEach(Func fn) const {
+    for (size_t i = 0; i < count; ++i) {
+      if (!fn(entries[i].deadline, entries[i].slot)) {
+        break;
+      }
+    }
+  }
+
+  bool isEmpty() const { return count == 0; }
+  bool isFull() const { return count >= SIZE; }
+  size_t size() const { return count; }
+  static constexpr size_t capacity() { return SIZE; }
+
+  void clear() { count = 0; }
+
+private:
+  struct Entry {
+    uint32_t deadline;
+    uint8_t slot;
+  };
+
+  Entry entries[SIZE];
+  size_t count;
+
+  static bool before(const Entry &a, const Entry &b) {
+    return static_cast<int32_t>(a.deadline - b.deadline) < 0;
+  }
+
+  bool find(uint8_t slot, size_t &index) const {
+    for (size_t i = 0; i < count; ++i) {
+      if (entries[i].slot == slot) {
+        index = i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool removeAt(size_t index) {
+    count--;
+    if (index != count) {
+      entries[index] = entries[count];
+      siftUp(index);
+      siftDown(index);
+    }
+    return true;
+  }
+
+  void siftUp(size_t index) {
+    Entry item = entries[index];
+    while (index > 0) {
+      size_t parent = (index - 1) / 2;
+      if (!before(item, entries[parent])) {
+        break;
+      }
+      entries[index] = entries[parent];
+      index = parent;
+    }
+    entries[index] = item;
+  }
+
+  void siftDown(size_t index) {
+    Entry item = entries[index];
+    while (true) {
+      size_t child = 2 * index + 1;
+      if (child >= count) {
+        break;
+      }
+      if (child + 1 < count && before(entries[child + 1], entries[child])) {
+        child++;
+      }
+      if (!before(entries[child], item)) {
+        break;
+      }
+      entries[index] = entries[child];
+      index = child;
+    }
+    entries[index] = item;
+  }
+};
+
+} // namespace MeshCore
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace MeshCore {
+
+/**
+ * Open-addressing set of 32-bit hashes with an expiry time per entry.
+ * Optimized for embedded systems with no dynamic allocation.
+ *
+ * Entries live within MAX_PROBE slots of their home bucket, so lookups
+ * and inserts touch a bounded number of slots. Expired entries are not
+ * swept; inserts reuse them (or evict the oldest entry in the window)
+ * and lookups skip them.
+ *
+ * @tparam SIZE Number of slots, must be a power of two
+ * @tparam TIMEOUT_MS Entry lifetime in milliseconds
+ */
+template <size_t SIZE, uint32_t TIMEOUT_MS> class ExpiringHashSet {
+public:
+  static constexpr size_t MAX_PROBE = 16;
+
+  static_assert(SIZE >= MAX_PROBE && (SIZE & (SIZE - 1)) == 0,
+                "ExpiringHashSet size must be a power of two >= MAX_PROBE");
+
+  ExpiringHashSet() { clear(); }
+
+  /**
+   * Check whether a hash was inserted within the last TIMEOUT_MS
+   */
+  bool contains(uint32_t hash, uint32_t now) const {
+    hash = toKey(hash);
+    size_t index = bucketOf(hash);
+    for (size_t i = 0; i < MAX_PROBE; ++i) {
+      const Entry &entry = entries[(index + i) & MASK];
+      if (entry.hash == EMPTY) {
+        return false; // Slots never return to empty, nothing beyond
+      }
+      if (entry.hash == hash && !isExpired(entry, now)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Insert or refresh a hash. Never fails; when the probe window holds
+   * only live entries the oldest one is evicted.
+   */
+  void insert(uint32_t hash, uint32_t now) {
+    hash = toKey(hash);
+    size_t index = bucketOf(hash);
+    Entry *freeSlot = nullptr;
+    Entry *oldest = nullptr;
+
+    for (size_t i = 0; i < MAX_PROBE; ++i) {
+      Entry &entry = entries[(index + i) & MASK];
+      if (entry.hash == hash) {
+        entry.timestamp = now;
+        return;
+      }
+      if (entry.hash == EMPTY || isExpired(entry, now)) {
+        if (freeSlot == nullptr) {
+          freeSlot = &entry;
+        }
+        if (entry.hash == EMPTY) {
+          break;
+        }
+        continue;
+      }
+      if (oldest == nullptr ||
+          now - entry.timestamp > now - oldest->timestamp) {
+        oldest = &entry;
+      }
+    }
+
+    Entry *target = freeSlot;
+    if (target == nullptr) {
+      target = oldest;
+      evictionCount++;
+    }
+    target->hash = hash;
+    target->timestamp = now;
+  }
+
+  /**
+   * Forget a hash so it reads as unseen. The slot is back-dated to
+   * expired rather than emptied, keeping entries past it reachable.
+   */
+  void erase(uint32_t hash, uint32_t now) {
+    hash = toKey(hash);
+    size_t index = bucketOf(hash);
+    for (size_t i = 0; i < MAX_PROBE; ++i) {
+      Entry &entry = entries[(index + i) & MASK];
+      if (entry.hash == EMPTY) {
+        return;
+      }
+      if (entry.hash == hash && !isExpired(entry, now)) {
+        entry.timestamp = now - TIMEOUT_MS - 1;
+        return;
+      }
+    }
+  }
+
+  /**
+   * Remove all entries
+   */
+  void clear() {
+    memset(entries, 0, sizeof(entries));
+    evictionCount = 0;
+  }
+
+  /**
+   * Live entries displaced before expiring; non-zero means SIZE is too
+   * small for the traffic
+   */
+  uint32_t getEvictionCount() const { return evictionCount; }
+
+  static constexpr size_t capacity() { return SIZE; }
+
+private:
+  struct Entry {
+    uint32_t hash;      // EMPTY marks a never-used slot
+    uint32_t timestamp;
+  };
+
+  static constexpr uint32_t EMPTY = 0;
+  static constexpr size_t MASK = SIZE - 1;
+
+  Entry entries[SIZE];
+  uint32_t evictionCount;
+
+  static uint32_t toKey(uint32_t hash) { return hash == EMPTY ? 1 : hash; }
+
+  static size_t bucketOf(uint32_t hash) {
+    // Fold the high bits in; FNV low bits alone cluster on similar payloads
+    return static_cast<size_t>(hash ^ (hash >> 16)) & MASK;
+  }
+
+  static bool isExpired(const Entry &entry, uint32_t now) {
+    return now - entry.timestamp > TIMEOUT_MS;
+  }
+};
+
+} // namespace MeshCore
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace MeshCore {
+
+/**
+ * Variable-length frame storage in a fixed byte arena.
+ * Optimized for embedded systems with no dynamic allocation.
+ *
+ * Each frame is contiguous and addressed by a small slot index that
+ * stays valid until released, so queues can order slot indices instead
+ * of moving frame bytes. Allocation is best fit over the gaps between
+ * live frames; the frames themselves are never moved.
+ *
+ * @tparam SLOTS Maximum number of frames held at once
+ * @tparam BYTES Arena size in bytes
+ */
+template <size_t SLOTS, size_t BYTES> class FrameSlab {
+public:
+  static constexpr uint8_t INVALID_SLOT = 0xFF;
+
+  static_assert(SLOTS > 0 && SLOTS < INVALID_SLOT,
+                "FrameSlab slot count must fit in a uint8_t index");
+  static_assert(BYTES <= 0xFFFF, "FrameSlab arena must fit 16-bit offsets");
+
+  FrameSlab() { clear(); }
+
+  /**
+   * Reserve space for a frame
+   *
+   * @return Slot index, or INVALID_SLOT if no slot or gap is large enough
+   */
+  uint8_t allocate(uint16_t length) {
+    if (length == 0 || length > BYTES || orderCount >= SLOTS) {
+      return INVALID_SLOT;
+    }
+
+    // Best fit over the gaps between frames, kept sorted by offset
+    size_t bestPosition = SLOTS;
+    uint16_t bestOffset = 0;
+    size_t bestGap = BYTES + 1;
+    size_t gapStart = 0;
+    for (size_t i = 0; i <= orderCount; ++i) {
+      size_t gapEnd = (i < orderCount) ? offsets[order[i]] : BYTES;
+      size_t gap = gapEnd - gapStart;
+      if (gap >= length && gap < bestGap) {
+        bestGap = gap;
+        bestPosition = i;
+        bestOffset = static_cast<uint16_t>(gapStart);
+      }
+      if (i < orderCount) {
+        gapStart = offsets[order[i]] + lengths[order[i]];
+      }
+    }
+    if (bestPosition == SLOTS) {
+      return INVALID_SLOT;
+    }
+
+    uint8_t slot = 0;
+    while (lengths[slot] != 0) {
+      slot++;
+    }
+
+    for (size_t i = orderCount; i > bestPosition; --i) {
+      order[i] = order[i - 1];
+    }
+    order[bestPosition] = slot;
+    orderCount++;
+
+    offsets[slot] = bestOffset;
+    lengths[slot] = length;
+    usedBytes += length;
+    return slot;
+  }
+
+  /**
+   * Return a frame's space to the arena
+   */
+  void release(uint8_t slot) {
+    if (slot >= SLOTS || lengths[slot] == 0) {
+      return;
+    }
+    size_t position = 0;
+    while (order[position] != slot) {
+      position++;
+    }
+    for (size_t i = position; i + 1 < orderCount; ++i) {
+      order[i] = order[i + 1];
+    }
+    orderCount--;
+    usedBytes -= lengths[slot];
+    lengths[slot] = 0;
+  }
+
+  /**
+   * Trim a frame to its final length, returning the tail to the arena.
+   * Lets a writer reserve the largest size it may need up front.
+   */
+  void shrink(uint8_t slot, uint16_t length) {
+    if (slot >= SLOTS || length == 0 || length > lengths[slot]) {
+      return;
+    }
+    usedBytes -= lengths[slot] - length;
+    lengths[slot] = length;
+  }
+
+  uint8_t *data(uint8_t slot) { return &arena[offsets[slot]]; }
+  const uint8_t *data(uint8_t slot) const { return &arena[offsets[slot]]; }
+  uint16_t length(uint8_t slot) const { return lengths[slot]; }
+
+  size_t getCount() const { return orderCount; }
+  size_t getUsedBytes() const { return usedBytes; }
+  static constexpr size_t capacity() { return SLOTS; }
+
+  /**
+   * Release all frames
+   */
+  void clear() {
+    memset(lengths, 0, sizeof(lengths));
+    orderCount = 0;
+    usedBytes = 0;
+  }
+
+private:
+  uint8_t arena[BYTES];
+  uint16_t offsets[SLOTS];
+  uint16_t lengths[SLOTS];  // 0 marks a free slot
+  uint8_t order[SLOTS];     // Live slots sorted by offset
+  uint8_t orderCount;
+  uint16_t usedBytes;
+};
+
+} // namespace MeshCore
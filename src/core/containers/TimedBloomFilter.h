@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace MeshCore {
+
+/**
+ * Two-generation Bloom filter over 32-bit hashes.
+ * Optimized for embedded systems with no dynamic allocation.
+ *
+ * Inserts go to the current generation; lookups check both. Every
+ * WINDOW_MS / 2 the older generation is cleared and becomes current, so
+ * a hash is remembered for between half and all of WINDOW_MS.
+ *
+ * False positives are measured, not just estimated: each insert also
+ * looks up a salted decoy of the hash that was never inserted, and any
+ * decoy hit is a false positive.
+ *
+ * @tparam BITS Bits per generation, must be a power of two
+ * @tparam HASHES Bit positions set per hash
+ * @tparam WINDOW_MS Retention window in milliseconds
+ */
+template <size_t BITS, uint8_t HASHES, uint32_t WINDOW_MS>
+class TimedBloomFilter {
+public:
+  static_assert(BITS >= 64 && (BITS & (BITS - 1)) == 0,
+                "TimedBloomFilter size must be a power of two >= 64");
+  static_assert(HASHES >= 1, "TimedBloomFilter needs at least one hash");
+
+  TimedBloomFilter() { clear(); }
+
+  /**
+   * Check whether a hash may have been inserted within the window
+   */
+  bool contains(uint32_t hash, uint32_t now) {
+    rotate(now);
+    lookupCount++;
+    bool found = test(generations[0], hash) || test(generations[1], hash);
+    if (found) {
+      hitCount++;
+    }
+    return found;
+  }
+
+  void insert(uint32_t hash, uint32_t now) {
+    rotate(now);
+
+    decoyCount++;
+    uint32_t decoy = hash ^ DECOY_SALT;
+    if (test(generations[0], decoy) || test(generations[1], decoy)) {
+      falsePositiveCount++;
+    }
+
+    uint32_t h1, h2;
+    split(hash, h1, h2);
+    for (uint8_t i = 0; i < HASHES; ++i) {
+      uint32_t bit = (h1 + i * h2) & (BITS - 1);
+      generations[current][bit >> 3] |= static_cast<uint8_t>(1u << (bit & 7));
+    }
+  }
+
+  /**
+   * Remove all entries and reset counters
+   */
+  void clear() {
+    memset(generations, 0, sizeof(generations));
+    current = 0;
+    generationStart = 0;
+    started = false;
+    lookupCount = 0;
+    hitCount = 0;
+    decoyCount = 0;
+    falsePositiveCount = 0;
+  }
+
+  uint32_t getLookupCount() const { return lookupCount; }
+  uint32_t getHitCount() const { return hitCount; }
+
+  // Measured false-positive rate = falsePositives / decoyChecks
+  uint32_t getDecoyCheckCount() const { return decoyCount; }
+  uint32_t getFalsePositiveCount() const { return falsePositiveCount; }
+
+  static constexpr size_t sizeBytes() { return 2 * BYTES; }
+
+private:
+  static constexpr size_t BYTES = BITS / 8;
+  static constexpr uint32_t GENERATION_MS = WINDOW_MS / 2;
+  static constexpr uint32_t DECOY_SALT = 0xA5C3E1F7u;
+
+  uint8_t generations[2][BYTES];
+  uint8_t current;
+  bool started;
+  uint32_t generationStart;
+  uint32_t lookupCount;
+  uint32_t hitCount;
+  uint32_t decoyCount;
+  uint32_t falsePositiveCount;
+
+  void rotate(uint32_t now) {
+    if (!started) {
+      generationStart = now;
+      started = true;
+      return;
+    }
+    uint32_t elapsed = now - generationStart;
+    if (elapsed < GENERATION_MS) {
+      return;
+    }
+    // After a long silence both generations are stale
+    if (elapsed >= WINDOW_MS) {
+      memset(generations, 0, sizeof(generations));
+    } else {
+      current ^= 1;
+      memset(generations[current], 0, BYTES);
+    }
+    generationStart = now;
+  }
+
+  static void split(uint32_t hash, uint32_t &h1, uint32_t &h2) {
+    // Double hashing (Kirsch-Mitzenmacher); h2 odd so probes differ
+    h1 = hash;
+    h2 = ((hash >> 16) | (hash << 16)) * 0x9E3779B1u | 1u;
+  }
+
+  static bool test(const uint8_t *bits, uint32_t hash) {
+    uint32_t h1, h2;
+    split(hash, h1, h2);
+    for (uint8_t i = 0; i < HASHES; ++i) {
+      uint32_t bit = (h1 + i * h2) & (BITS - 1);
+      if ((bits[bit >> 3] & (1u << (bit & 7))) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace MeshCore
@@ -3,7 +3,7 @@
 namespace MeshCrypto {
 
 namespace {
-static const uint8_t sbox[256] PROGMEM = {
+constexpr uint8_t sbox[256] PROGMEM = {
     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
     0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
     0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26,
@@ -27,7 +27,7 @@ static const uint8_t sbox[256] PROGMEM = {
     0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f,
     0xb0, 0x54, 0xbb, 0x16};
 
-static const uint8_t rsbox[256] PROGMEM = {
+constexpr uint8_t rsbox[256] PROGMEM = {
     0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e,
     0x81, 0xf3, 0xd7, 0xfb, 0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87,
     0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb, 0x54, 0x7b, 0x94, 0x32,
@@ -51,12 +51,12 @@ static const uint8_t rsbox[256] PROGMEM = {
     0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63,
     0x55, 0x21, 0x0c, 0x7d};
 
-static const uint8_t Rcon[11] PROGMEM = {0x8d, 0x01, 0x02, 0x04, 0x08,
+constexpr uint8_t Rcon[11] PROGMEM = {0x8d, 0x01, 0x02, 0x04, 0x08,
                                          0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
 
-inline uint8_t xtime(uint8_t x) { return (x << 1) ^ (((x >> 7) & 1) * 0x1b); }
+constexpr uint8_t xtime(uint8_t x) { return (x << 1) ^ (((x >> 7) & 1) * 0x1b); }
 
-inline uint8_t multiply(uint8_t x, uint8_t y) {
+constexpr uint8_t multiply(uint8_t x, uint8_t y) {
   return (((y & 1) * x) ^ ((y >> 1 & 1) * xtime(x)) ^
           ((y >> 2 & 1) * xtime(xtime(x))) ^
           ((y >> 3 & 1) * xtime(xtime(xtime(x)))) ^
@@ -154,11 +154,120 @@ void addRoundKey(uint8_t *state, const uint8_t *roundKey) {
   }
 }
 
+void expandKey(const uint8_t key[16], uint8_t roundKey[176]) {
+  memcpy(roundKey, key, 16);
+  uint8_t bytesGenerated = 16;
+  uint8_t rconIteration = 1;
+  uint8_t temp[4];
+
+  while (bytesGenerated < 176) {
+    memcpy(temp, roundKey + bytesGenerated - 4, 4);
+
+    if (bytesGenerated % 16 == 0) {
+      // rotate
+      uint8_t t = temp[0];
+      temp[0] = temp[1];
+      temp[1] = temp[2];
+      temp[2] = temp[3];
+      temp[3] = t;
+      // sub bytes
+      temp[0] = pgm_read_byte(&sbox[temp[0]]);
+      temp[1] = pgm_read_byte(&sbox[temp[1]]);
+      temp[2] = pgm_read_byte(&sbox[temp[2]]);
+      temp[3] = pgm_read_byte(&sbox[temp[3]]);
+      temp[0] ^= pgm_read_byte(&Rcon[rconIteration]);
+      rconIteration++;
+    }
+
+    for (uint8_t i = 0; i < 4; ++i) {
+      roundKey[bytesGenerated] =
+          roundKey[bytesGenerated - 16] ^ temp[i];
+      bytesGenerated++;
+    }
+  }
+}
+
+// --- T-tables ---
+
+constexpr uint32_t word(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) {
+  return static_cast<uint32_t>(b0) | (static_cast<uint32_t>(b1) << 8) |
+         (static_cast<uint32_t>(b2) << 16) | (static_cast<uint32_t>(b3) << 24);
+}
+
+// MixColumns / InvMixColumns of a column holding only s in row 0
+constexpr uint32_t encryptEntry(uint8_t s) {
+  return word(xtime(s), s, s, xtime(s) ^ s);
+}
+
+constexpr uint32_t decryptEntry(uint8_t s) {
+  return word(multiply(s, 0x0e), multiply(s, 0x09), multiply(s, 0x0d),
+              multiply(s, 0x0b));
+}
+
+struct WordTable {
+  uint32_t words[256];
+};
+
+template <uint16_t... Is> struct Indices {};
+template <uint16_t N, uint16_t... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+template <uint16_t... Is> struct MakeIndices<0, Is...> {
+  typedef Indices<Is...> Type;
+};
+
+template <uint16_t... Is> constexpr WordTable buildEncrypt(Indices<Is...>) {
+  return WordTable{{encryptEntry(sbox[Is])...}};
+}
+
+template <uint16_t... Is> constexpr WordTable buildDecrypt(Indices<Is...>) {
+  return WordTable{{decryptEntry(rsbox[Is])...}};
+}
+
+constexpr WordTable TE = buildEncrypt(MakeIndices<256>::Type());
+constexpr WordTable TD = buildDecrypt(MakeIndices<256>::Type());
+
+static_assert(TE.words[0x00] == 0xa56363c6 && TE.words[0xff] == 0x3a16162c,
+              "AES encryption T-table");
+static_assert(TD.words[0x00] == 0x50a7f451 && TD.words[0xff] == 0x4257b8d0,
+              "AES decryption T-table");
+
+inline uint32_t rotl(uint32_t x, uint8_t n) { return (x << n) | (x >> (32 - n)); }
+
+inline uint32_t load32(const uint8_t *p) { return word(p[0], p[1], p[2], p[3]); }
+
+inline void store32(uint8_t *p, uint32_t w) {
+  p[0] = static_cast<uint8_t>(w);
+  p[1] = static_cast<uint8_t>(w >> 8);
+  p[2] = static_cast<uint8_t>(w >> 16);
+  p[3] = static_cast<uint8_t>(w >> 24);
+}
+
+// One output column from row r of the r-th argument
+inline uint32_t mixColumn(const WordTable &table, uint32_t a, uint32_t b,
+                          uint32_t c, uint32_t d) {
+  return table.words[a & 0xFF] ^ rotl(table.words[(b >> 8) & 0xFF], 8) ^
+         rotl(table.words[(c >> 16) & 0xFF], 16) ^ rotl(table.words[d >> 24], 24);
+}
+
+// InvMixColumns of one column; TD of an S-box output undoes the S-box
+inline uint32_t invMixColumn(uint32_t w) {
+  return TD.words[pgm_read_byte(&sbox[w & 0xFF])] ^
+         rotl(TD.words[pgm_read_byte(&sbox[(w >> 8) & 0xFF])], 8) ^
+         rotl(TD.words[pgm_read_byte(&sbox[(w >> 16) & 0xFF])], 16) ^
+         rotl(TD.words[pgm_read_byte(&sbox[w >> 24])], 24);
+}
+
+inline uint32_t subColumn(const uint8_t *box, uint32_t a, uint32_t b,
+                          uint32_t c, uint32_t d) {
+  return word(pgm_read_byte(&box[a & 0xFF]), pgm_read_byte(&box[(b >> 8) & 0xFF]),
+              pgm_read_byte(&box[(c >> 16) & 0xFF]), pgm_read_byte(&box[d >> 24]));
+}
+
 } // namespace
 
 AES128::AES128() { memset(roundKey, 0, sizeof(roundKey)); }
 
-void AES128::setKey(const uint8_t key[16]) { keyExpansion(key); }
+void AES128::setKey(const uint8_t key[16]) { expandKey(key, roundKey); }
 
 void AES128::encryptBlock(uint8_t output[16], const uint8_t input[16]) const {
   uint8_t state[16];
@@ -200,38 +309,79 @@ void AES128::decryptBlock(uint8_t output[16], const uint8_t input[16]) const {
   memcpy(output, state, 16);
 }
 
-void AES128::keyExpansion(const uint8_t key[16]) {
-  memcpy(roundKey, key, 16);
-  uint8_t bytesGenerated = 16;
-  uint8_t rconIteration = 1;
-  uint8_t temp[4];
-
-  while (bytesGenerated < 176) {
-    memcpy(temp, roundKey + bytesGenerated - 4, 4);
+AES128Table::AES128Table() {
+  memset(encryptKey, 0, sizeof(encryptKey));
+  memset(decryptKey, 0, sizeof(decryptKey));
+}
 
-    if (bytesGenerated % 16 == 0) {
-      // rotate
-      uint8_t t = temp[0];
-      temp[0] = temp[1];
-      temp[1] = temp[2];
-      temp[2] = temp[3];
-      temp[3] = t;
-      // sub bytes
-      temp[0] = pgm_read_byte(&sbox[temp[0]]);
-      temp[1] = pgm_read_byte(&sbox[temp[1]]);
-      temp[2] = pgm_read_byte(&sbox[temp[2]]);
-      temp[3] = pgm_read_byte(&sbox[temp[3]]);
-      temp[0] ^= pgm_read_byte(&Rcon[rconIteration]);
-      rconIteration++;
-    }
+void AES128Table::setKey(const uint8_t key[16]) {
+  uint8_t bytes[176];
+  expandKey(key, bytes);
+  for (uint8_t i = 0; i < 44; ++i) {
+    encryptKey[i] = load32(&bytes[i * 4]);
+  }
 
+  // Equivalent inverse cipher: rounds reversed, InvMixColumns applied to
+  // the inner ones
+  for (uint8_t round = 0; round <= 10; ++round) {
     for (uint8_t i = 0; i < 4; ++i) {
-      roundKey[bytesGenerated] =
-          roundKey[bytesGenerated - 16] ^ temp[i];
-      bytesGenerated++;
+      uint32_t w = encryptKey[(10 - round) * 4 + i];
+      decryptKey[round * 4 + i] = (round > 0 && round < 10) ? invMixColumn(w) : w;
     }
   }
 }
 
+void AES128Table::encryptBlock(uint8_t output[16], const uint8_t input[16]) const {
+  const uint32_t *rk = encryptKey;
+  uint32_t s0 = load32(input) ^ rk[0];
+  uint32_t s1 = load32(input + 4) ^ rk[1];
+  uint32_t s2 = load32(input + 8) ^ rk[2];
+  uint32_t s3 = load32(input + 12) ^ rk[3];
+
+  for (uint8_t round = 1; round <= 9; ++round) {
+    rk += 4;
+    uint32_t t0 = mixColumn(TE, s0, s1, s2, s3) ^ rk[0];
+    uint32_t t1 = mixColumn(TE, s1, s2, s3, s0) ^ rk[1];
+    uint32_t t2 = mixColumn(TE, s2, s3, s0, s1) ^ rk[2];
+    uint32_t t3 = mixColumn(TE, s3, s0, s1, s2) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  rk += 4;
+  store32(output, subColumn(sbox, s0, s1, s2, s3) ^ rk[0]);
+  store32(output + 4, subColumn(sbox, s1, s2, s3, s0) ^ rk[1]);
+  store32(output + 8, subColumn(sbox, s2, s3, s0, s1) ^ rk[2]);
+  store32(output + 12, subColumn(sbox, s3, s0, s1, s2) ^ rk[3]);
+}
+
+void AES128Table::decryptBlock(uint8_t output[16], const uint8_t input[16]) const {
+  const uint32_t *rk = decryptKey;
+  uint32_t s0 = load32(input) ^ rk[0];
+  uint32_t s1 = load32(input + 4) ^ rk[1];
+  uint32_t s2 = load32(input + 8) ^ rk[2];
+  uint32_t s3 = load32(input + 12) ^ rk[3];
+
+  for (uint8_t round = 1; round <= 9; ++round) {
+    rk += 4;
+    uint32_t t0 = mixColumn(TD, s0, s3, s2, s1) ^ rk[0];
+    uint32_t t1 = mixColumn(TD, s1, s0, s3, s2) ^ rk[1];
+    uint32_t t2 = mixColumn(TD, s2, s1, s0, s3) ^ rk[2];
+    uint32_t t3 = mixColumn(TD, s3, s2, s1, s0) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  rk += 4;
+  store32(output, subColumn(rsbox, s0, s3, s2, s1) ^ rk[0]);
+  store32(output + 4, subColumn(rsbox, s1, s0, s3, s2) ^ rk[1]);
+  store32(output + 8, subColumn(rsbox, s2, s1, s0, s3) ^ rk[2]);
+  store32(output + 12, subColumn(rsbox, s3, s2, s1, s0) ^ rk[3]);
+}
+
 } // namespace MeshCrypto
 
@@ -18,8 +18,27 @@ public:
 
 private:
   uint8_t roundKey[176];
+};
+
+/**
+ * AES-128 ECB with 32-bit T-tables, same interface as AES128.
+ * Each round is 16 word lookups and XORs instead of byte-wise SubBytes
+ * and MixColumns. One 1 KB table per direction, built at compile time,
+ * is rotated for the other rows (ROR is a single cycle on Cortex-M0).
+ * Decryption uses the equivalent inverse cipher, so a second schedule
+ * with InvMixColumns applied is kept next to the encryption keys.
+ */
+class AES128Table {
+public:
+  AES128Table();
 
-  void keyExpansion(const uint8_t key[16]);
+  void setKey(const uint8_t key[16]);
+  void encryptBlock(uint8_t output[16], const uint8_t input[16]) const;
+  void decryptBlock(uint8_t output[16], const uint8_t input[16]) const;
+
+private:
+  uint32_t encryptKey[44];  // Columns, row 0 in the low byte
+  uint32_t decryptKey[44];  // Reversed, InvMixColumns on rounds 1-9
 };
 
 } // namespace MeshCrypto
@@ -1,5 +1,4 @@
 #include "CryptoUtils.h"
-#include "AES128.h"
 #include "SHA256.h"
 
 namespace MeshCrypto {
@@ -13,17 +12,54 @@ void CryptoUtils::sha256(uint8_t *hash, size_t hashLen, const uint8_t *msg,
   memcpy(hash, full, hashLen);
 }
 
+void ChannelKey::setKey(const uint8_t *key, size_t keyLen) {
+  // HMAC over the secret zero padded to PUB_KEY_SIZE, as MeshCore does
+  uint8_t secret[MeshCoreCompat::PUB_KEY_SIZE];
+  if (keyLen > sizeof(secret)) {
+    keyLen = sizeof(secret);
+  }
+  memset(secret, 0, sizeof(secret));
+  memcpy(secret, key, keyLen);
+  cipher.setKey(secret);
+  mac.setKey(secret, sizeof(secret));
+}
+
 int CryptoUtils::encrypt(const uint8_t *sharedSecret, uint8_t *dest,
                          const uint8_t *src, int srcLen) {
-  AES128 aes;
-  aes.setKey(sharedSecret);
+  ChannelKey key;
+  key.setKey(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE);
+  return encrypt(key, dest, src, srcLen);
+}
+
+int CryptoUtils::decrypt(const uint8_t *sharedSecret, uint8_t *dest,
+                         const uint8_t *src, int srcLen) {
+  ChannelKey key;
+  key.setKey(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE);
+  return decrypt(key, dest, src, srcLen);
+}
 
+int CryptoUtils::encryptThenMAC(const uint8_t *sharedSecret, uint8_t *dest,
+                                const uint8_t *src, int srcLen) {
+  ChannelKey key;
+  key.setKey(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE);
+  return encryptThenMAC(key, dest, src, srcLen);
+}
+
+int CryptoUtils::MACThenDecrypt(const uint8_t *sharedSecret, uint8_t *dest,
+                                const uint8_t *src, int srcLen) {
+  ChannelKey key;
+  key.setKey(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE);
+  return MACThenDecrypt(key, dest, src, srcLen);
+}
+
+int CryptoUtils::encrypt(const ChannelKey &key, uint8_t *dest,
+                         const uint8_t *src, int srcLen) {
   uint8_t *dp = dest;
   const uint8_t *sp = src;
   int len = srcLen;
 
   while (len >= 16) {
-    aes.encryptBlock(dp, sp);
+    key.cipher.encryptBlock(dp, sp);
     dp += 16;
     sp += 16;
     len -= 16;
@@ -33,27 +69,25 @@ int CryptoUtils::encrypt(const uint8_t *sharedSecret, uint8_t *dest,
     uint8_t tmp[16];
     memset(tmp, 0, sizeof(tmp));
     memcpy(tmp, sp, len);
-    aes.encryptBlock(dp, tmp);
+    key.cipher.encryptBlock(dp, tmp);
     dp += 16;
   }
 
   return dp - dest;
 }
 
-int CryptoUtils::decrypt(const uint8_t *sharedSecret, uint8_t *dest,
+int CryptoUtils::decrypt(const ChannelKey &key, uint8_t *dest,
                          const uint8_t *src, int srcLen) {
   if (srcLen % 16 != 0) {
     return 0;
   }
-  AES128 aes;
-  aes.setKey(sharedSecret);
 
   uint8_t *dp = dest;
   const uint8_t *sp = src;
   const uint8_t *end = src + srcLen;
 
   while (sp < end) {
-    aes.decryptBlock(dp, sp);
+    key.cipher.decryptBlock(dp, sp);
     dp += 16;
     sp += 16;
   }
@@ -61,35 +95,37 @@ int CryptoUtils::decrypt(const uint8_t *sharedSecret, uint8_t *dest,
   return srcLen;
 }
 
-int CryptoUtils::encryptThenMAC(const uint8_t *sharedSecret, uint8_t *dest,
+int CryptoUtils::encryptThenMAC(const ChannelKey &key, uint8_t *dest,
                                 const uint8_t *src, int srcLen) {
   uint8_t *cipher = dest + MeshCoreCompat::CIPHER_MAC_SIZE;
-  int encLen = encrypt(sharedSecret, cipher, src, srcLen);
+  int encLen = encrypt(key, cipher, src, srcLen);
 
   uint8_t mac[32];
-  SHA256::hmac(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE, cipher, encLen, mac);
+  key.mac.compute(cipher, encLen, mac);
   memcpy(dest, mac, MeshCoreCompat::CIPHER_MAC_SIZE);
 
   return MeshCoreCompat::CIPHER_MAC_SIZE + encLen;
 }
 
-int CryptoUtils::MACThenDecrypt(const uint8_t *sharedSecret, uint8_t *dest,
+int CryptoUtils::MACThenDecrypt(const ChannelKey &key, uint8_t *dest,
                                 const uint8_t *src, int srcLen) {
-  if (srcLen <= MeshCoreCompat::CIPHER_MAC_SIZE) {
+  if (!verifyMAC(key, src, srcLen)) {
     return 0;
   }
+  return decrypt(key, dest, src + MeshCoreCompat::CIPHER_MAC_SIZE,
+                 srcLen - MeshCoreCompat::CIPHER_MAC_SIZE);
+}
 
-  const uint8_t *cipher = src + MeshCoreCompat::CIPHER_MAC_SIZE;
-  int cipherLen = srcLen - MeshCoreCompat::CIPHER_MAC_SIZE;
-
-  uint8_t mac[32];
-  SHA256::hmac(sharedSecret, MeshCoreCompat::PUB_KEY_SIZE, cipher, cipherLen,
-               mac);
-  if (memcmp(mac, src, MeshCoreCompat::CIPHER_MAC_SIZE) != 0) {
-    return 0;
+bool CryptoUtils::verifyMAC(const ChannelKey &key, const uint8_t *src,
+                            int srcLen) {
+  if (srcLen <= MeshCoreCompat::CIPHER_MAC_SIZE) {
+    return false;
   }
 
-  return decrypt(sharedSecret, dest, cipher, cipherLen);
+  uint8_t mac[32];
+  key.mac.compute(src + MeshCoreCompat::CIPHER_MAC_SIZE,
+                  srcLen - MeshCoreCompat::CIPHER_MAC_SIZE, mac);
+  return memcmp(mac, src, MeshCoreCompat::CIPHER_MAC_SIZE) == 0;
 }
 
 static int base64Value(char c) {
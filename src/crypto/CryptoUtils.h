@@ -1,10 +1,34 @@
 #pragma once
 
 #include <Arduino.h>
+#include "AES128.h"
+#include "SHA256.h"
+#include "../core/Config.h"
 #include "../mesh/MeshCrypto.h"
 
 namespace MeshCrypto {
 
+// Block cipher behind channel keys, chosen by Config::Crypto::AES_TTABLES
+template <bool TABLES> struct ChannelCipher {
+  typedef AES128 Type;
+};
+template <> struct ChannelCipher<true> {
+  typedef AES128Table Type;
+};
+
+/**
+ * Shared secret with its AES key schedule and HMAC pad midstates
+ * computed up front. Set once per key, then passed to the CryptoUtils
+ * overloads so each packet skips key expansion and the two pad-block
+ * compressions.
+ */
+struct ChannelKey {
+  ChannelCipher<Config::Crypto::AES_TTABLES>::Type cipher;
+  HMACSHA256 mac;
+
+  void setKey(const uint8_t *key, size_t keyLen);
+};
+
 class CryptoUtils {
 public:
   static void sha256(uint8_t *hash, size_t hashLen, const uint8_t *msg,
@@ -17,6 +41,19 @@ public:
                             const uint8_t *src, int srcLen);
   static int MACThenDecrypt(const uint8_t *sharedSecret, uint8_t *dest,
                             const uint8_t *src, int srcLen);
+
+  // Same as above with a pre-expanded key
+  static int encrypt(const ChannelKey &key, uint8_t *dest, const uint8_t *src,
+                     int srcLen);
+  static int decrypt(const ChannelKey &key, uint8_t *dest, const uint8_t *src,
+                     int srcLen);
+  static int encryptThenMAC(const ChannelKey &key, uint8_t *dest,
+                            const uint8_t *src, int srcLen);
+  static int MACThenDecrypt(const ChannelKey &key, uint8_t *dest,
+                            const uint8_t *src, int srcLen);
+
+  // Check the MAC in front of src without decrypting anything
+  static bool verifyMAC(const ChannelKey &key, const uint8_t *src, int srcLen);
 };
 
 int base64Decode(const char *input, uint8_t *output, size_t maxLen);
@@ -58,6 +58,12 @@ void SHA256::reset() {
   memset(ctx.buffer, 0, sizeof(ctx.buffer));
 }
 
+// Continue from the chaining state left by exactly one 64-byte block
+void SHA256::resume(const uint32_t midstate[8]) {
+  memcpy(ctx.state, midstate, sizeof(ctx.state));
+  ctx.bitCount = 64 * 8;
+}
+
 void SHA256::transform(const uint8_t block[64]) {
   uint32_t w[64];
   for (uint8_t i = 0; i < 16; ++i) {
@@ -148,6 +154,17 @@ void SHA256::finalize(uint8_t digest[32]) {
 
 void SHA256::hmac(const uint8_t *key, size_t keyLen, const uint8_t *data,
                   size_t dataLen, uint8_t digest[32]) {
+  HMACSHA256 mac;
+  mac.setKey(key, keyLen);
+  mac.compute(data, dataLen, digest);
+}
+
+HMACSHA256::HMACSHA256() {
+  memcpy(innerState, kInitState, sizeof(innerState));
+  memcpy(outerState, kInitState, sizeof(outerState));
+}
+
+void HMACSHA256::setKey(const uint8_t *key, size_t keyLen) {
   uint8_t k0[64];
   memset(k0, 0, sizeof(k0));
 
@@ -159,23 +176,33 @@ void SHA256::hmac(const uint8_t *key, size_t keyLen, const uint8_t *data,
     memcpy(k0, key, keyLen);
   }
 
-  uint8_t innerPad[64];
-  uint8_t outerPad[64];
+  uint8_t pad[64];
+  SHA256 sha;
   for (uint8_t i = 0; i < 64; ++i) {
-    innerPad[i] = k0[i] ^ 0x36;
-    outerPad[i] = k0[i] ^ 0x5C;
+    pad[i] = k0[i] ^ 0x36;
   }
+  sha.transform(pad);
+  memcpy(innerState, sha.ctx.state, sizeof(innerState));
+
+  sha.reset();
+  for (uint8_t i = 0; i < 64; ++i) {
+    pad[i] = k0[i] ^ 0x5C;
+  }
+  sha.transform(pad);
+  memcpy(outerState, sha.ctx.state, sizeof(outerState));
+}
 
-  SHA256 shaInner;
-  shaInner.update(innerPad, 64);
-  shaInner.update(data, dataLen);
+void HMACSHA256::compute(const uint8_t *data, size_t dataLen,
+                         uint8_t digest[32]) const {
+  SHA256 sha;
+  sha.resume(innerState);
+  sha.update(data, dataLen);
   uint8_t innerHash[32];
-  shaInner.finalize(innerHash);
+  sha.finalize(innerHash);
 
-  SHA256 shaOuter;
-  shaOuter.update(outerPad, 64);
-  shaOuter.update(innerHash, 32);
-  shaOuter.finalize(digest);
+  sha.resume(outerState);
+  sha.update(innerHash, 32);
+  sha.finalize(digest);
 }
 
 } // namespace MeshCrypto
@@ -22,10 +22,31 @@ public:
                    size_t dataLen, uint8_t digest[32]);
 
 private:
+  friend class HMACSHA256;
+
   void transform(const uint8_t block[64]);
+  void resume(const uint32_t midstate[8]);
 
   SHA256Context ctx;
 };
 
+/**
+ * HMAC-SHA256 with the key's inner and outer pad blocks hashed once.
+ * Only the chaining state after each 64-byte pad block is kept, so a MAC
+ * costs the message blocks plus one outer compression instead of also
+ * re-hashing both pads every time.
+ */
+class HMACSHA256 {
+public:
+  HMACSHA256();
+
+  void setKey(const uint8_t *key, size_t keyLen);
+  void compute(const uint8_t *data, size_t dataLen, uint8_t digest[32]) const;
+
+private:
+  uint32_t innerState[8];  // After the ipad block
+  uint32_t outerState[8];  // After the opad block
+};
+
 } // namespace MeshCrypto
 
@@ -6,6 +6,7 @@
 #include "core/CryptoIdentity.h"
 #include "core/Logger.h"
 #include "core/NodeConfig.h"
+#include "core/Profiler.h"
 #include "mesh/channels/PrivateChannelAnnouncer.h"
 #include "mesh/processors/Deduplicator.h"
 #include "mesh/processors/PacketForwarder.h"
@@ -14,9 +15,13 @@
 #include "mesh/processors/NeighborMonitor.h"
 #include "mesh/processors/TraceHandler.h"
 #include "mesh/processors/DiscoveryResponder.h"
+#include "mesh/RxPrefilter.h"
+#include "mesh/StaticPipeline.h"
 #include "power/PowerManager.h"
+#include "power/WakeDeadline.h"
 #include "radio/LoRaReceiver.h"
 #include "radio/LoRaTransmitter.h"
+#include "radio/TxScheduler.h"
 
 static MeshCore::Deduplicator deduplicator;
 static MeshCore::PacketLogger packetLogger;
@@ -25,6 +30,58 @@ static MeshCore::PacketForwarder packetForwarder;
 static CommandHandler commandHandler;
 static NeighborMonitor neighborMonitor;
 static MeshCore::DiscoveryResponder discoveryResponder;
+static MeshCore::RxPrefilter rxPrefilter(deduplicator);
+
+// Stands in for the StaticPipeline when Config::Dispatcher::STATIC_PIPELINE
+// is off, so the pipeline template is never instantiated
+struct DisabledPipeline {
+  template <typename... Stages> explicit DisabledPipeline(Stages &...) {}
+  void dispatchPacket(const MeshCore::PacketEvent &) {}
+  static constexpr size_t stageCount() { return 0; }
+};
+
+typedef MeshCore::PipelineDetail::Select<
+    Config::Dispatcher::STATIC_PIPELINE,
+    MeshCore::StaticPipeline<MeshCore::Deduplicator, MeshCore::PacketLogger,
+                             CommandHandler, NeighborMonitor,
+                             MeshCore::DiscoveryResponder,
+                             MeshCore::TraceHandler, MeshCore::PacketForwarder>,
+    DisabledPipeline>::Type Pipeline;
+
+static Pipeline staticPipeline(deduplicator, packetLogger, commandHandler,
+                               neighborMonitor, discoveryResponder,
+                               traceHandler, packetForwarder);
+
+static void dispatchStatic(const MeshCore::PacketEvent &event) {
+  staticPipeline.dispatchPacket(event);
+}
+
+// Sleep until a radio interrupt or the earliest scheduled transmission
+static void sleepUntilNextDeadline() {
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  WakeDeadline wake(millis());
+  uint32_t deadline;
+  if (scheduler.getNextDeadline(deadline)) {
+    wake.add(deadline);
+  }
+  // Only forwards the scheduler would take now; the rest wait for TX done
+  // or the scheduler's own deadline
+  if (Config::Forwarding::ENABLED &&
+      packetForwarder.getNextDeadline(deadline)) {
+    wake.add(deadline);
+  }
+
+  // While transmitting, due work waits for TX done, which wakes us anyway
+  if (!wake.isPending() || LoRaTransmitter::getInstance().isTransmitting()) {
+    PowerManager::getInstance().sleep();
+    return;
+  }
+
+  uint32_t remaining = wake.remainingMs();
+  if (remaining >= Config::Power::MIN_TIMED_SLEEP_MS) {
+    PowerManager::getInstance().sleep(remaining);
+  }
+}
 
 void setup() {
 #ifdef ENABLE_LOGGING
@@ -44,15 +101,24 @@ void setup() {
 
   MeshCore::PacketDispatcher &dispatcher =
       MeshCore::PacketDispatcher::getInstance();
-  dispatcher.addProcessor(&deduplicator);
-  dispatcher.addProcessor(&packetLogger);
-  dispatcher.addProcessor(&commandHandler);
-  dispatcher.addProcessor(&neighborMonitor);
-  dispatcher.addProcessor(&discoveryResponder);
+  if (Config::Dispatcher::STATIC_PIPELINE) {
+    // Trace handler and forwarder check Forwarding::ENABLED themselves
+    dispatcher.setPipeline(dispatchStatic);
+  } else {
+    dispatcher.addProcessor(&deduplicator);
+    dispatcher.addProcessor(&packetLogger);
+    dispatcher.addProcessor(&commandHandler);
+    dispatcher.addProcessor(&neighborMonitor);
+    dispatcher.addProcessor(&discoveryResponder);
+  }
 
   if (Config::Forwarding::ENABLED) {
-    dispatcher.addProcessor(&traceHandler);
-    dispatcher.addProcessor(&packetForwarder);
+    if (!Config::Dispatcher::STATIC_PIPELINE) {
+      dispatcher.addProcessor(&traceHandler);
+      dispatcher.addProcessor(&packetForwarder);
+    }
+    deduplicator.setDuplicateListener(&packetForwarder);
+    commandHandler.setForwarder(&packetForwarder);
 
     uint16_t nodeId = MeshCore::NodeConfig::getInstance().getNodeId();
     uint8_t nodeHash = MeshCore::NodeConfig::getInstance().getNodeHash();
@@ -66,9 +132,12 @@ void setup() {
   }
 
   LOG_INFO_FMT("Registered %d packet processors",
-               dispatcher.getProcessorCount());
+               Config::Dispatcher::STATIC_PIPELINE
+                   ? static_cast<int>(staticPipeline.stageCount())
+                   : static_cast<int>(dispatcher.getProcessorCount()));
 
   LoRaReceiver &receiver = LoRaReceiver::getInstance();
+  receiver.setRxFilter(&rxPrefilter);
   receiver.initialize();
   LOG_INFO("LoRa receiver initialized");
 
@@ -90,20 +159,20 @@ void loop() {
     packetForwarder.loop();
   }
 
-  // Command handler (only process if has pending response)
-  commandHandler.loop();
-  
-  // Discovery responder (only process if has pending response)
-  discoveryResponder.loop();
+  // Start any queued transmission that has come due
+  TxScheduler::getInstance().loop();
+
+#ifdef ENABLE_PROFILING
+  static uint32_t lastProfileReport = 0;
+  if (Config::Logging::PROFILE_REPORT_INTERVAL_MS > 0 &&
+      millis() - lastProfileReport >= Config::Logging::PROFILE_REPORT_INTERVAL_MS) {
+    lastProfileReport = millis();
+    Profiler::getInstance().logReport();
+  }
+#endif
 
   // Power management - sleep when possible
   if (Config::Power::LIGHT_SLEEP_ENABLED) {
-    bool hasPendingWork = (Config::Forwarding::ENABLED && 
-                           packetForwarder.hasPendingPackets()) ||
-                          commandHandler.hasPendingResponse() ||
-                          discoveryResponder.hasPendingResponse();
-    if (!hasPendingWork) {
-      PowerManager::getInstance().sleep();
-    }
+    sleepUntilNextDeadline();
   }
 }
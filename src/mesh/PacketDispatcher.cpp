@@ -1,5 +1,7 @@
 #include "PacketDispatcher.h"
 #include "../core/Logger.h"
+#include "../core/Profiler.h"
+#include <string.h>
 
 namespace MeshCore {
 
@@ -19,6 +21,7 @@ void PacketDispatcher::addProcessor(IPacketProcessor *processor) {
 
   processors[processorCount++] = processor;
   sortProcessorsByPriority();
+  rebuildDispatchTable();
 }
 
 void PacketDispatcher::removeProcessor(IPacketProcessor *processor) {
@@ -28,6 +31,7 @@ void PacketDispatcher::removeProcessor(IPacketProcessor *processor) {
         processors[j] = processors[j + 1];
       }
       processorCount--;
+      rebuildDispatchTable();
       break;
     }
   }
@@ -46,24 +50,54 @@ void PacketDispatcher::sortProcessorsByPriority() {
   }
 }
 
-void PacketDispatcher::dispatchPacket(const PacketEvent &event) {
-  ProcessingContext ctx;
+void PacketDispatcher::rebuildDispatchTable() {
+  memset(byPayloadTypeCount, 0, sizeof(byPayloadTypeCount));
 
   for (size_t i = 0; i < processorCount; ++i) {
-    if (processors[i] != nullptr) {
-      ProcessResult result = processors[i]->processPacket(event, ctx);
-
-      if (result == ProcessResult::DROP) {
-        LOG_DEBUG_FMT("Packet dropped by processor: %s",
-                      processors[i]->getName());
-        return;
-      } else if (result == ProcessResult::STOP) {
-        LOG_DEBUG_FMT("Pipeline stopped by processor: %s",
-                      processors[i]->getName());
-        return;
+    PacketInterest interest = processors[i]->getInterest();
+    routeMasks[i] = interest.routeTypes;
+
+    for (size_t type = 0; type < PAYLOAD_TYPE_COUNT; ++type) {
+      if (interest.payloadTypes & (1u << type)) {
+        byPayloadType[type][byPayloadTypeCount[type]++] =
+            static_cast<uint8_t>(i);
       }
     }
   }
 }
 
+void PacketDispatcher::dispatchPacket(const PacketEvent &event) {
+  if (pipeline != nullptr) {
+    pipeline(event);
+    return;
+  }
+
+  ProcessingContext ctx;
+
+  uint8_t type = static_cast<uint8_t>(event.packet.payloadType) &
+                 (PAYLOAD_TYPE_COUNT - 1);
+  uint8_t routeBit = PacketInterest::route(event.packet.routeType);
+  const uint8_t *stages = byPayloadType[type];
+
+  for (size_t i = 0; i < byPayloadTypeCount[type]; ++i) {
+    uint8_t index = stages[i];
+    if ((routeMasks[index] & routeBit) == 0) {
+      continue;
+    }
+
+    IPacketProcessor *processor = processors[index];
+    PROFILE_START(stageStart);
+    ProcessResult result = processor->processPacket(event, ctx);
+    PROFILE_STAGE(index, processor->getName(), result, stageStart);
+
+    if (result == ProcessResult::DROP) {
+      LOG_DEBUG_FMT("Packet dropped by processor: %s", processor->getName());
+      return;
+    } else if (result == ProcessResult::STOP) {
+      LOG_DEBUG_FMT("Pipeline stopped by processor: %s", processor->getName());
+      return;
+    }
+  }
+}
+
 } // namespace MeshCore
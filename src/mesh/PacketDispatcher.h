@@ -7,17 +7,49 @@ namespace MeshCore {
 
 struct PacketEvent {
   const DecodedPacket &packet;
+  const uint8_t *raw;    // Received frame bytes, valid during dispatch only
+  uint16_t rawLength;
   int16_t rssi;
   int8_t snr;
   uint32_t timestamp;
   mutable uint32_t hash; // Computed hash for deduplication (mutable cache field)
+  bool cachedOnReceive;  // RX filter already checked and cached the hash
 
-  PacketEvent(const DecodedPacket &p, int16_t r, int8_t s, uint32_t t)
-      : packet(p), rssi(r), snr(s), timestamp(t), hash(0) {}
+  PacketEvent(const DecodedPacket &p, const uint8_t *f, uint16_t l, int16_t r,
+              int8_t s, uint32_t t, bool cached = false)
+      : packet(p), raw(f), rawLength(l), rssi(r), snr(s), timestamp(t),
+        hash(0), cachedOnReceive(cached) {}
 };
 
 enum class ProcessResult : uint8_t { CONTINUE, STOP, DROP };
 
+/**
+ * Packets a processor wants to see: one bit per PayloadType and per
+ * RouteType. The dispatcher skips the processor for anything else.
+ */
+struct PacketInterest {
+  uint16_t payloadTypes;
+  uint8_t routeTypes;
+
+  static constexpr uint16_t ALL_PAYLOAD_TYPES = 0xFFFF;
+  static constexpr uint8_t ALL_ROUTE_TYPES = 0x0F;
+
+  static constexpr uint16_t payload(PayloadType type) {
+    return static_cast<uint16_t>(1u << static_cast<uint8_t>(type));
+  }
+  static constexpr uint8_t route(RouteType type) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(type));
+  }
+
+  static constexpr PacketInterest all() {
+    return PacketInterest{ALL_PAYLOAD_TYPES, ALL_ROUTE_TYPES};
+  }
+  static constexpr PacketInterest only(uint16_t payloadTypes,
+                                       uint8_t routeTypes = ALL_ROUTE_TYPES) {
+    return PacketInterest{payloadTypes, routeTypes};
+  }
+};
+
 struct ProcessingContext {
   bool isDuplicate = false;
   bool shouldForward = false;
@@ -43,6 +75,9 @@ public:
                                       ProcessingContext &ctx) = 0;
   virtual const char *getName() const = 0;
   virtual uint8_t getPriority() const = 0;
+
+  // Read once at registration; must not change afterwards
+  virtual PacketInterest getInterest() const { return PacketInterest::all(); }
 };
 
 class PacketDispatcher {
@@ -53,16 +88,37 @@ public:
   void removeProcessor(IPacketProcessor *processor);
   void dispatchPacket(const PacketEvent &event);
 
+  // Route every packet to a compile-time pipeline (see StaticPipeline.h)
+  // instead of the registered processors; nullptr restores the table
+  typedef void (*PipelineFn)(const PacketEvent &event);
+  void setPipeline(PipelineFn fn) { pipeline = fn; }
+
   size_t getProcessorCount() const { return processorCount; }
 
 private:
-  PacketDispatcher() : processorCount(0), processors{nullptr} {}
+  PacketDispatcher()
+      : processors{nullptr}, processorCount(0), routeMasks{0},
+        byPayloadType{{0}}, byPayloadTypeCount{0}, pipeline(nullptr) {}
 
   static constexpr size_t MAX_PROCESSORS = Config::Dispatcher::MAX_PROCESSORS;
+  static constexpr size_t PAYLOAD_TYPE_COUNT = 16;  // 4-bit header field
+
+  static_assert(MAX_PROCESSORS <= 0xFF,
+                "Dispatch table stores processor indices as uint8_t");
+
   IPacketProcessor *processors[MAX_PROCESSORS];
   size_t processorCount;
 
+  // Dispatch table: for each payload type, the interested processors in
+  // priority order, plus each processor's route-type mask
+  uint8_t routeMasks[MAX_PROCESSORS];
+  uint8_t byPayloadType[PAYLOAD_TYPE_COUNT][MAX_PROCESSORS];
+  uint8_t byPayloadTypeCount[PAYLOAD_TYPE_COUNT];
+
+  PipelineFn pipeline;
+
   void sortProcessorsByPriority();
+  void rebuildDispatchTable();
 
   PacketDispatcher(const PacketDispatcher &) = delete;
   PacketDispatcher &operator=(const PacketDispatcher &) = delete;
@@ -4,52 +4,103 @@
 
 namespace MeshCore {
 
-PacketQueue::PacketQueue()
-    : readIndex(0), writeIndex(0), count(0), droppedCount(0) {
-  for (size_t i = 0; i < QUEUE_SIZE; ++i) {
-    queue[i].valid = false;
-  }
+PacketQueue::PacketQueue() : evictedCount(0), dropListener(nullptr) {
+  memset(fifoHead, 0, sizeof(fifoHead));
+  memset(fifoCount, 0, sizeof(fifoCount));
+  memset(droppedCount, 0, sizeof(droppedCount));
 }
 
-bool PacketQueue::enqueue(const DecodedPacket &packet, int16_t rssi, int8_t snr,
-                          uint32_t timestamp) {
-  if (isFull()) {
-    droppedCount++;
-    LOG_WARN_FMT("Packet queue full, dropping packet (total dropped: %lu)",
-                 droppedCount);
+bool PacketQueue::enqueue(const uint8_t *frame, uint16_t length, int16_t rssi,
+                          int8_t snr, uint32_t timestamp, uint32_t tag) {
+  if (frame == nullptr || length == 0 ||
+      length > Config::Queue::MAX_FRAME_SIZE) {
     return false;
   }
 
-  memcpy(&queue[writeIndex].packet, &packet, sizeof(DecodedPacket));
-  queue[writeIndex].rssi = rssi;
-  queue[writeIndex].snr = snr;
-  queue[writeIndex].timestamp = timestamp;
-  queue[writeIndex].valid = true;
+  TrafficClass trafficClass = classifyFrame(frame, length);
+  uint8_t classIndex = static_cast<uint8_t>(trafficClass);
+
+  // Evicted frames may leave scattered gaps, so retry until one fits
+  uint8_t slot = frames.allocate(length);
+  while (slot == frames.INVALID_SLOT && evictBelow(classIndex)) {
+    slot = frames.allocate(length);
+  }
+  if (slot == frames.INVALID_SLOT) {
+    droppedCount[classIndex]++;
+    LOG_WARN_FMT("Packet queue full, dropping %s packet (dropped: %lu)",
+                 trafficClassName(trafficClass), droppedCount[classIndex]);
+    return false;
+  }
 
-  writeIndex = (writeIndex + 1) % QUEUE_SIZE;
-  count++;
+  memcpy(frames.data(slot), frame, length);
+  entries[slot].timestamp = timestamp;
+  entries[slot].tag = tag;
+  entries[slot].rssi = rssi;
+  entries[slot].snr = snr;
+  push(classIndex, slot);
 
   return true;
 }
 
 bool PacketQueue::dequeue(QueuedPacket &outPacket) {
-  if (isEmpty()) {
-    return false;
+  for (uint8_t classIndex = 0; classIndex < TRAFFIC_CLASS_COUNT; ++classIndex) {
+    if (fifoCount[classIndex] == 0) {
+      continue;
+    }
+
+    uint8_t slot = pop(classIndex);
+    outPacket.length = static_cast<uint8_t>(frames.length(slot));
+    outPacket.rssi = entries[slot].rssi;
+    outPacket.snr = entries[slot].snr;
+    outPacket.timestamp = entries[slot].timestamp;
+    outPacket.tag = entries[slot].tag;
+    memcpy(outPacket.data, frames.data(slot), outPacket.length);
+    frames.release(slot);
+    return true;
   }
+  return false;
+}
 
-  if (!queue[readIndex].valid) {
-    readIndex = (readIndex + 1) % QUEUE_SIZE;
-    count--;
-    return false;
+uint32_t PacketQueue::getDroppedCount() const {
+  uint32_t total = 0;
+  for (size_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i) {
+    total += droppedCount[i];
   }
+  return total;
+}
 
-  memcpy(&outPacket, &queue[readIndex], sizeof(QueuedPacket));
-  queue[readIndex].valid = false;
+void PacketQueue::push(uint8_t classIndex, uint8_t slot) {
+  size_t tail = (fifoHead[classIndex] + fifoCount[classIndex]) % SLOTS;
+  fifo[classIndex][tail] = slot;
+  fifoCount[classIndex]++;
+}
 
-  readIndex = (readIndex + 1) % QUEUE_SIZE;
-  count--;
+uint8_t PacketQueue::pop(uint8_t classIndex) {
+  uint8_t slot = fifo[classIndex][fifoHead[classIndex]];
+  fifoHead[classIndex] = static_cast<uint8_t>((fifoHead[classIndex] + 1) % SLOTS);
+  fifoCount[classIndex]--;
+  return slot;
+}
 
-  return true;
+bool PacketQueue::evictBelow(uint8_t classIndex) {
+  // Lowest class first, oldest frame within it
+  for (uint8_t victim = TRAFFIC_CLASS_COUNT - 1; victim > classIndex; --victim) {
+    if (fifoCount[victim] == 0) {
+      continue;
+    }
+
+    uint8_t slot = pop(victim);
+    frames.release(slot);
+    if (dropListener != nullptr && entries[slot].tag != 0) {
+      dropListener->onDropped(entries[slot].tag);
+    }
+    droppedCount[victim]++;
+    evictedCount++;
+    LOG_DEBUG_FMT("Packet queue full, evicted oldest %s packet",
+                  trafficClassName(static_cast<TrafficClass>(victim)));
+    return true;
+  }
+  return false;
 }
 
 } // namespace MeshCore
@@ -1,39 +1,93 @@
 #pragma once
 
 #include "../core/Config.h"
-#include "../core/PacketDecoder.h"
+#include "../core/containers/FrameSlab.h"
+#include "TrafficClass.h"
+#include <Arduino.h>
 
 namespace MeshCore {
 
 struct QueuedPacket {
-  DecodedPacket packet;
+  uint8_t data[Config::Queue::MAX_FRAME_SIZE];
+  uint8_t length;
   int16_t rssi;
   int8_t snr;
   uint32_t timestamp;
-  bool valid;
+  uint32_t tag;
 };
 
+/**
+ * Told about queued frames that are evicted before anyone dequeues them.
+ */
+class IQueueDropListener {
+public:
+  virtual ~IQueueDropListener() = default;
+  virtual void onDropped(uint32_t tag) = 0;
+};
+
+/**
+ * Queue of raw received frames with their RSSI/SNR/timestamp.
+ * Frames are stored once in a FrameSlab and tagged with a TrafficClass;
+ * dequeue takes the highest class first and arrival order within a class.
+ * When a frame does not fit, the oldest frames of lower classes are
+ * evicted to make room. A frame never evicts its own class, so within a
+ * class the queue still tail-drops. Decoding is left to the consumer.
+ * Each frame carries an opaque tag from the producer, handed to the
+ * drop listener if the frame is evicted; 0 means untagged.
+ */
 class PacketQueue {
 public:
   PacketQueue();
 
-  bool enqueue(const DecodedPacket &packet, int16_t rssi, int8_t snr,
-               uint32_t timestamp);
+  bool enqueue(const uint8_t *frame, uint16_t length, int16_t rssi, int8_t snr,
+               uint32_t timestamp, uint32_t tag = 0);
   bool dequeue(QueuedPacket &outPacket);
 
-  bool isEmpty() const { return count == 0; }
-  bool isFull() const { return count >= QUEUE_SIZE; }
-  size_t getCount() const { return count; }
-  uint32_t getDroppedCount() const { return droppedCount; }
+  void setDropListener(IQueueDropListener *listener) { dropListener = listener; }
+
+  bool isEmpty() const { return frames.getCount() == 0; }
+  size_t getCount() const { return frames.getCount(); }
+  size_t getCount(TrafficClass trafficClass) const {
+    return fifoCount[static_cast<uint8_t>(trafficClass)];
+  }
+  size_t getFreeBytes() const { return BUFFER_SIZE - frames.getUsedBytes(); }
+
+  // Frames lost per class, whether rejected on arrival or evicted later
+  uint32_t getDroppedCount() const;
+  uint32_t getDroppedCount(TrafficClass trafficClass) const {
+    return droppedCount[static_cast<uint8_t>(trafficClass)];
+  }
+  uint32_t getEvictedCount() const { return evictedCount; }
 
 private:
-  static constexpr size_t QUEUE_SIZE = Config::Queue::PACKET_QUEUE_SIZE;
+  static constexpr size_t SLOTS = Config::Queue::PACKET_QUEUE_SLOTS;
+  static constexpr size_t BUFFER_SIZE = Config::Queue::PACKET_QUEUE_BUFFER_SIZE;
+
+  static_assert(BUFFER_SIZE >= Config::Queue::MAX_FRAME_SIZE,
+                "Packet queue must hold at least one maximum-size frame");
+
+  struct Entry {
+    uint32_t timestamp;
+    uint32_t tag;
+    int16_t rssi;
+    int8_t snr;
+  };
+
+  FrameSlab<SLOTS, BUFFER_SIZE> frames;
+  Entry entries[SLOTS];
+
+  // Per-class rings of slot indices in arrival order
+  uint8_t fifo[TRAFFIC_CLASS_COUNT][SLOTS];
+  uint8_t fifoHead[TRAFFIC_CLASS_COUNT];
+  uint8_t fifoCount[TRAFFIC_CLASS_COUNT];
+
+  uint32_t droppedCount[TRAFFIC_CLASS_COUNT];
+  uint32_t evictedCount;
+  IQueueDropListener *dropListener;
 
-  QueuedPacket queue[QUEUE_SIZE];
-  size_t readIndex;
-  size_t writeIndex;
-  size_t count;
-  uint32_t droppedCount;
+  void push(uint8_t classIndex, uint8_t slot);
+  uint8_t pop(uint8_t classIndex);
+  bool evictBelow(uint8_t classIndex);
 };
 
 } // namespace MeshCore
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../core/Config.h"
+#include "../radio/Airtime.h"
+#include <stdint.h>
+
+/**
+ * SNR-weighted receive delay for flood forwarding, built at compile time
+ * from Config::Forwarding.
+ *
+ *   score = clamp((SNR - SNR_MIN_DB) / SNR_RANGE_DB, 0, 1)
+ *   delay = multiplier(score) * airtime
+ *
+ * EXPONENTIAL is MeshCore's RX_DELAY_BASE^(0.85 - score) - 1, LINEAR a
+ * straight line with the same end points, and STEPPED the exponential
+ * held over RX_DELAY_STEPS equal score buckets. Multipliers below zero
+ * (the strongest links) clamp to no delay.
+ *
+ * Scores and multipliers are Q16 fixed point (65536 = 1.0). The curve is
+ * sampled into a small knot table at compile time and linearly
+ * interpolated at run time, so the forwarding path does no float math.
+ */
+namespace RxDelayCurve {
+
+typedef Config::Forwarding::RxDelayShape Shape;
+
+constexpr uint32_t ONE = 65536;  // 1.0 in Q16
+constexpr double EXPONENT_OFFSET = 0.85;
+
+// --- Compile-time math (C++11 constexpr, recursion only) ---
+
+constexpr double LN2 = 0.69314718055994530942;
+
+constexpr double square(double x) { return x * x; }
+
+constexpr double expTaylor(double x, double term, int n) {
+  return n > 20 ? term : term + expTaylor(x, term * x / n, n + 1);
+}
+
+// Halve the argument until the series converges fast, then square back
+constexpr double constExp(double x) {
+  return (x > 0.5 || x < -0.5) ? square(constExp(x / 2)) : expTaylor(x, 1.0, 1);
+}
+
+constexpr double lnSeries(double y, double power, int n) {
+  return n > 41 ? 0.0 : power / n + lnSeries(y, power * y * y, n + 2);
+}
+
+// ln(x) = 2 atanh((x - 1) / (x + 1)) after scaling x into [1, 2)
+constexpr double constLn(double x) {
+  return x >= 2.0   ? constLn(x / 2) + LN2
+         : x < 1.0  ? constLn(x * 2) - LN2
+                    : 2 * lnSeries((x - 1) / (x + 1), (x - 1) / (x + 1), 1);
+}
+
+constexpr double power(double base, double exponent) {
+  return constExp(exponent * constLn(base));
+}
+
+constexpr double exponential(double score) {
+  return power(Config::Forwarding::RX_DELAY_BASE, EXPONENT_OFFSET - score) - 1.0;
+}
+
+constexpr double multiplier(Shape shape, double score) {
+  return Config::Forwarding::RX_DELAY_BASE <= 0.0f ? 0.0
+         : shape == Shape::LINEAR
+             ? exponential(0.0) * (1.0 - score / EXPONENT_OFFSET)
+         : shape == Shape::STEPPED
+             ? exponential(static_cast<double>(static_cast<uint32_t>(
+                               score * Config::Forwarding::RX_DELAY_STEPS)) /
+                           Config::Forwarding::RX_DELAY_STEPS)
+             : exponential(score);
+}
+
+constexpr uint32_t toQ16(double value) {
+  return value <= 0.0 ? 0 : static_cast<uint32_t>(value * ONE + 0.5);
+}
+
+// --- Knot table ---
+
+constexpr Shape SHAPE = Config::Forwarding::RX_DELAY_SHAPE;
+
+// STEPPED keeps one knot per bucket and is not interpolated
+constexpr uint32_t SEGMENTS =
+    SHAPE == Shape::STEPPED ? Config::Forwarding::RX_DELAY_STEPS : 32;
+
+struct Table {
+  uint32_t knots[SEGMENTS + 1];  // Q16 multiplier at score = i / SEGMENTS
+};
+
+template <uint32_t... Is> struct Indices {};
+template <uint32_t N, uint32_t... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+template <uint32_t... Is> struct MakeIndices<0, Is...> {
+  typedef Indices<Is...> Type;
+};
+
+template <uint32_t... Is> constexpr Table buildTable(Indices<Is...>) {
+  return Table{{toQ16(multiplier(SHAPE, static_cast<double>(Is) / SEGMENTS))...}};
+}
+
+constexpr Table TABLE = buildTable(MakeIndices<SEGMENTS + 1>::Type());
+
+// --- Run time ---
+
+// SNR arrives in 0.25 dB units; score = (snr - SNR_MIN) * 65536 / RANGE,
+// done as a multiply by a Q8 reciprocal to avoid a division
+constexpr int32_t SNR_MIN_UNITS = static_cast<int32_t>(
+    Config::Forwarding::SNR_MIN_DB * Config::Forwarding::SNR_SCALE_FACTOR);
+constexpr uint32_t SNR_RANGE_UNITS = static_cast<uint32_t>(
+    Config::Forwarding::SNR_RANGE_DB * Config::Forwarding::SNR_SCALE_FACTOR);
+constexpr uint32_t SCORE_SCALE_Q8 =
+    (static_cast<uint64_t>(ONE) * 256 + SNR_RANGE_UNITS / 2) / SNR_RANGE_UNITS;
+
+inline uint32_t score(int8_t snr) {
+  int32_t offset = static_cast<int32_t>(snr) - SNR_MIN_UNITS;
+  if (offset <= 0) {
+    return 0;
+  }
+  if (static_cast<uint32_t>(offset) >= SNR_RANGE_UNITS) {
+    return ONE;
+  }
+  return (static_cast<uint32_t>(offset) * SCORE_SCALE_Q8) >> 8;
+}
+
+inline uint32_t multiplierQ16(uint32_t scoreQ16) {
+  uint32_t position = scoreQ16 * SEGMENTS;  // Q16 knot position
+  uint32_t index = position >> 16;
+  if (index >= SEGMENTS) {
+    return TABLE.knots[SEGMENTS];
+  }
+  if (SHAPE == Shape::STEPPED) {
+    return TABLE.knots[index];
+  }
+  int32_t lower = static_cast<int32_t>(TABLE.knots[index]);
+  int32_t delta = static_cast<int32_t>(TABLE.knots[index + 1]) - lower;
+  int32_t fraction = static_cast<int32_t>(position & 0xFFFF);
+  return static_cast<uint32_t>(lower + ((delta * fraction) >> 16));
+}
+
+inline uint32_t delayMs(uint32_t scoreQ16, uint32_t airtime) {
+  return (multiplierQ16(scoreQ16) * airtime) >> 16;
+}
+
+// --- Range checks for the fixed-point arithmetic ---
+
+constexpr uint32_t larger(uint32_t a, uint32_t b) { return a > b ? a : b; }
+constexpr uint32_t distance(uint32_t a, uint32_t b) { return a > b ? a - b : b - a; }
+
+constexpr uint32_t maxKnot(uint32_t i, uint32_t best) {
+  return i > SEGMENTS ? best : maxKnot(i + 1, larger(best, TABLE.knots[i]));
+}
+
+constexpr uint32_t maxStep(uint32_t i, uint32_t best) {
+  return i >= SEGMENTS
+             ? best
+             : maxStep(i + 1, larger(best, distance(TABLE.knots[i], TABLE.knots[i + 1])));
+}
+
+static_assert(SEGMENTS >= 1 && SEGMENTS < 0xFFFF,
+              "RX delay knot position must fit 32 bits");
+static_assert(SNR_RANGE_UNITS > 0 && SNR_RANGE_UNITS * SCORE_SCALE_Q8 <= 0xFFFFFFFFull,
+              "SNR score scaling must fit 32 bits");
+static_assert(static_cast<uint64_t>(maxKnot(0, 0)) *
+                      Airtime::configuredMs(Airtime::MAX_LENGTH) <= 0xFFFFFFFFull,
+              "RX_DELAY_BASE too large: delay multiply overflows 32 bits");
+static_assert(static_cast<uint64_t>(maxStep(0, 0)) * 0xFFFF <= 0x7FFFFFFFull,
+              "RX delay curve too steep for 32-bit interpolation");
+
+} // namespace RxDelayCurve
@@ -0,0 +1,54 @@
+#include "RxPrefilter.h"
+#include "../core/Logger.h"
+#include "../core/NodeConfig.h"
+
+namespace MeshCore {
+
+bool RxPrefilter::accept(const uint8_t *frame, uint16_t length,
+                         uint32_t timestamp, uint32_t &tag) {
+  FrameLayout layout;
+  if (!PacketDecoder::parseLayout(frame, length, layout)) {
+    return true;  // Let the decoder reject and log it
+  }
+
+  if (Config::Queue::PREFILTER_NOT_FOR_US &&
+      (layout.routeType == RouteType::DIRECT ||
+       layout.routeType == RouteType::TRANSPORT_DIRECT) &&
+      layout.payloadType != PayloadType::TRACE && layout.pathLength > 0 &&
+      frame[layout.pathLengthIndex + 1] !=
+          NodeConfig::getInstance().getNodeHash()) {
+    notForUsFiltered++;
+    LOG_DEBUG_FMT("RX prefilter: DIRECT for 0x%02X, not us",
+                  frame[layout.pathLengthIndex + 1]);
+    return false;
+  }
+
+  if (Config::Queue::PREFILTER_DUPLICATES) {
+    uint32_t hash = Deduplicator::computeFrameHash(frame, layout);
+    if (deduplicator.checkFrame(hash, timestamp)) {
+      duplicatesFiltered++;
+      return false;
+    }
+    // A hash of 0 stays untagged and is cached at dispatch instead
+    if (cachesQueuedFrames()) {
+      tag = hash;
+    }
+  }
+
+  return true;
+}
+
+void RxPrefilter::onQueued(uint32_t tag, uint32_t timestamp) {
+  // Only once queued: a frame the queue drops must not shadow its copies
+  if (tag != 0) {
+    deduplicator.recordFrame(tag, timestamp);
+  }
+}
+
+void RxPrefilter::onDropped(uint32_t tag) {
+  // Never dispatched, so a later copy is the first one to count
+  deduplicator.forgetFrame(tag, millis());
+  LOG_DEBUG_FMT("RX prefilter: forgot dropped frame 0x%08lX", tag);
+}
+
+} // namespace MeshCore
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../core/Config.h"
+#include "../core/PacketDecoder.h"
+#include "../radio/LoRaReceiver.h"
+#include "processors/Deduplicator.h"
+
+namespace MeshCore {
+
+/**
+ * Rejects frames in the RX callback that the pipeline would discard
+ * anyway, so flood storms do not crowd unique traffic out of the RX
+ * queue. Works on header bytes only, before any decode:
+ * - Copies already in the Deduplicator's cache (the duplicate is still
+ *   counted and reported to its listener). A frame that gets queued is
+ *   cached at once, so later copies are rejected even while the first
+ *   still waits in the queue. Its hash is the queue tag, and the entry
+ *   is forgotten again if the frame is evicted or fails to decode.
+ *   Needs a cache that can forget (Deduplicator::CAN_FORGET); with
+ *   the Bloom filter, copies are only checked against dispatched frames.
+ * - DIRECT frames whose next hop is another node. TRACE is exempt, its
+ *   path carries SNRs rather than hops.
+ */
+class RxPrefilter : public IRxFilter {
+public:
+  explicit RxPrefilter(Deduplicator &dedup)
+      : deduplicator(dedup), duplicatesFiltered(0), notForUsFiltered(0) {}
+  ~RxPrefilter() override = default;
+
+  bool accept(const uint8_t *frame, uint16_t length, uint32_t timestamp,
+              uint32_t &tag) override;
+  void onQueued(uint32_t tag, uint32_t timestamp) override;
+  void onDropped(uint32_t tag) override;
+  bool cachesQueuedFrames() const override {
+    return Config::Queue::PREFILTER_DUPLICATES && Deduplicator::CAN_FORGET;
+  }
+
+  uint32_t getDuplicatesFiltered() const { return duplicatesFiltered; }
+  uint32_t getNotForUsFiltered() const { return notForUsFiltered; }
+
+private:
+  Deduplicator &deduplicator;
+  uint32_t duplicatesFiltered;
+  uint32_t notForUsFiltered;
+};
+
+} // namespace MeshCore
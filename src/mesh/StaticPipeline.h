@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../core/Logger.h"
+#include "../core/Profiler.h"
+#include "PacketDispatcher.h"
+
+namespace MeshCore {
+
+// Compile-time type list helpers for StaticPipeline
+namespace PipelineDetail {
+
+template <typename... Ts> struct TypeList {};
+
+template <bool C, typename A, typename B> struct Select {
+  typedef A Type;
+};
+template <typename A, typename B> struct Select<false, A, B> {
+  typedef B Type;
+};
+
+template <typename T, typename List> struct Prepend;
+template <typename T, typename... Ts> struct Prepend<T, TypeList<Ts...>> {
+  typedef TypeList<T, Ts...> Type;
+};
+
+// Insert T before the first stage with a higher PRIORITY
+template <typename T, typename List> struct Insert;
+template <typename T> struct Insert<T, TypeList<>> {
+  typedef TypeList<T> Type;
+};
+template <typename T, typename H, typename... Ts>
+struct Insert<T, TypeList<H, Ts...>> {
+  typedef typename Select<
+      (T::PRIORITY <= H::PRIORITY), TypeList<T, H, Ts...>,
+      typename Prepend<H, typename Insert<T, TypeList<Ts...>>::Type>::Type>::Type
+      Type;
+};
+
+template <typename... Ts> struct Sort;
+template <> struct Sort<> {
+  typedef TypeList<> Type;
+};
+template <typename H, typename... Ts> struct Sort<H, Ts...> {
+  typedef typename Insert<H, typename Sort<Ts...>::Type>::Type Type;
+};
+
+template <typename T> struct StageRef {
+  explicit StageRef(T &s) : stage(s) {}
+  T &stage;
+};
+
+} // namespace PipelineDetail
+
+/**
+ * Processing pipeline fixed at compile time.
+ *
+ * Equivalent to registering the same processors with PacketDispatcher,
+ * but the stage order is sorted from each stage's constexpr PRIORITY at
+ * compile time and every call is qualified, so stages are called (and
+ * usually inlined) without going through the vtable. Interest masks are
+ * honoured the same way as in the dynamic dispatcher.
+ *
+ * Stages are listed in any order and bound to existing instances:
+ *
+ *   StaticPipeline<Deduplicator, PacketForwarder, PacketLogger>
+ *       pipeline(deduplicator, forwarder, logger);
+ *
+ * Each stage type needs `static constexpr uint8_t PRIORITY` and may
+ * appear only once. Equal priorities keep their listed order.
+ */
+template <typename... Stages>
+class StaticPipeline : private PipelineDetail::StageRef<Stages>... {
+public:
+  explicit StaticPipeline(Stages &... stages)
+      : PipelineDetail::StageRef<Stages>(stages)... {}
+
+  void dispatchPacket(const PacketEvent &event) {
+    ProcessingContext ctx;
+    uint16_t payloadBit =
+        PacketInterest::payload(static_cast<PayloadType>(
+            static_cast<uint8_t>(event.packet.payloadType) & 0x0F));
+    uint8_t routeBit = PacketInterest::route(event.packet.routeType);
+    run(typename PipelineDetail::Sort<Stages...>::Type(), event, ctx,
+        payloadBit, routeBit);
+  }
+
+  static constexpr size_t stageCount() { return sizeof...(Stages); }
+
+private:
+  template <typename T> T &stage() {
+    return static_cast<PipelineDetail::StageRef<T> &>(*this).stage;
+  }
+
+  void run(PipelineDetail::TypeList<>, const PacketEvent &, ProcessingContext &,
+           uint16_t, uint8_t) {}
+
+  template <typename H, typename... Ts>
+  void run(PipelineDetail::TypeList<H, Ts...>, const PacketEvent &event,
+           ProcessingContext &ctx, uint16_t payloadBit, uint8_t routeBit) {
+    H &current = stage<H>();
+    PacketInterest interest = current.H::getInterest();
+    if ((interest.payloadTypes & payloadBit) != 0 &&
+        (interest.routeTypes & routeBit) != 0) {
+      PROFILE_START(stageStart);
+      ProcessResult result = current.H::processPacket(event, ctx);
+      PROFILE_STAGE(sizeof...(Stages) - sizeof...(Ts) - 1, current.H::getName(),
+                    result, stageStart);
+      if (result == ProcessResult::DROP) {
+        LOG_DEBUG_FMT("Packet dropped by processor: %s", current.H::getName());
+        return;
+      } else if (result == ProcessResult::STOP) {
+        LOG_DEBUG_FMT("Pipeline stopped by processor: %s", current.H::getName());
+        return;
+      }
+    }
+    run(PipelineDetail::TypeList<Ts...>(), event, ctx, payloadBit, routeBit);
+  }
+};
+
+} // namespace MeshCore
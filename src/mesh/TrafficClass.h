@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../core/PacketDecoder.h"
+#include <Arduino.h>
+
+namespace MeshCore {
+
+/**
+ * Queueing class of a frame, highest first. Routed replies and control
+ * traffic (DIRECT hops, ACK, PATH, TRACE) outrank messages, and messages
+ * outrank ADVERT floods, which are large, periodic and repeated.
+ */
+enum class TrafficClass : uint8_t { HIGH = 0, MEDIUM = 1, LOW = 2 };
+
+constexpr size_t TRAFFIC_CLASS_COUNT = 3;
+
+inline const char *trafficClassName(TrafficClass trafficClass) {
+  switch (trafficClass) {
+  case TrafficClass::HIGH:
+    return "high";
+  case TrafficClass::MEDIUM:
+    return "medium";
+  default:
+    return "low";
+  }
+}
+
+/**
+ * Classify a raw frame from its header byte
+ */
+inline TrafficClass classifyFrame(const uint8_t *frame, uint16_t length) {
+  if (frame == nullptr || length == 0) {
+    return TrafficClass::MEDIUM;
+  }
+  auto route = static_cast<RouteType>(frame[0] & PH_ROUTE_MASK);
+  auto type = static_cast<PayloadType>((frame[0] >> PH_TYPE_SHIFT) & PH_TYPE_MASK);
+
+  if (route == RouteType::DIRECT || route == RouteType::TRANSPORT_DIRECT ||
+      type == PayloadType::ACK || type == PayloadType::PATH ||
+      type == PayloadType::TRACE) {
+    return TrafficClass::HIGH;
+  }
+  if (type == PayloadType::ADVERT) {
+    return TrafficClass::LOW;
+  }
+  return TrafficClass::MEDIUM;
+}
+
+} // namespace MeshCore
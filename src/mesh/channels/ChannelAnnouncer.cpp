@@ -10,7 +10,7 @@ using namespace MeshCoreCompat;
 
 bool ChannelAnnouncer::buildPacketInternal(const char *text, uint8_t *rawPacket,
                                            uint16_t &length, uint32_t timestampSeconds,
-                                           const uint8_t *channelSecret, 
+                                           const MeshCrypto::ChannelKey &channelKey, 
                                            const uint8_t *channelHash) {
   MeshCore::DecodedPacket packet{};
   packet.routeType = MeshCore::RouteType::FLOOD;
@@ -36,7 +36,7 @@ bool ChannelAnnouncer::buildPacketInternal(const char *text, uint8_t *rawPacket,
   int plainLen = 5 + static_cast<int>(textLen);
 
   uint8_t cipher[CIPHER_MAC_SIZE + MAX_MESSAGE_LEN + 16];
-  int encLen = MeshCrypto::CryptoUtils::encryptThenMAC(channelSecret, cipher, 
+  int encLen = MeshCrypto::CryptoUtils::encryptThenMAC(channelKey, cipher, 
                                                        plaintext, plainLen);
   if (encLen <= 0 || encLen + PATH_HASH_SIZE > MeshCore::MAX_PACKET_PAYLOAD) {
     return false;
@@ -54,8 +54,31 @@ bool ChannelAnnouncer::buildPacketInternal(const char *text, uint8_t *rawPacket,
 bool ChannelAnnouncer::decodeMessageInternal(const MeshCore::DecodedPacket &packet,
                                              uint32_t &timestamp, char *textBuffer,
                                              size_t textBufferLen,
-                                             const uint8_t *channelSecret,
+                                             const MeshCrypto::ChannelKey &channelKey,
                                              const uint8_t *channelHash) {
+  MessageStream stream;
+  if (!openMessageInternal(packet, channelKey, channelHash, stream)) {
+    return false;
+  }
+  stream.decryptAll();
+  timestamp = stream.getTimestamp();
+
+  size_t maxCopy = textBufferLen > 0 ? textBufferLen - 1 : 0;
+  size_t actualLen = stream.getTextLength();
+  if (actualLen > maxCopy) {
+    actualLen = maxCopy;
+  }
+  if (textBufferLen > 0) {
+    memcpy(textBuffer, stream.getText(), actualLen);
+    textBuffer[actualLen] = '\0';
+  }
+  return true;
+}
+
+bool ChannelAnnouncer::openMessageInternal(const MeshCore::DecodedPacket &packet,
+                                           const MeshCrypto::ChannelKey &channelKey,
+                                           const uint8_t *channelHash,
+                                           MessageStream &stream) {
   if (packet.payloadType != MeshCore::PayloadType::GRP_TXT) {
     return false;
   }
@@ -68,32 +91,79 @@ bool ChannelAnnouncer::decodeMessageInternal(const MeshCore::DecodedPacket &pack
     return false;
   }
 
-  int cipherLen = packet.payloadLength - PATH_HASH_SIZE;
-  uint8_t plaintext[5 + MAX_MESSAGE_LEN];
-  int decLen = MeshCrypto::CryptoUtils::MACThenDecrypt(channelSecret, plaintext,
-                                                       packet.payload + PATH_HASH_SIZE,
-                                                       cipherLen);
-  if (decLen < 5) {
+  const uint8_t *data = packet.payload + PATH_HASH_SIZE;
+  int dataLen = packet.payloadLength - PATH_HASH_SIZE;
+  int cipherLen = dataLen - CIPHER_MAC_SIZE;
+  if (cipherLen % CIPHER_BLOCK_SIZE != 0 ||
+      cipherLen > static_cast<int>(MessageStream::MAX_CIPHER_LEN)) {
     return false;
   }
 
-  memcpy(&timestamp, plaintext, sizeof(timestamp));
-  TimeSync::updateFromRemote(timestamp);
-
-  size_t clampIndex = decLen < static_cast<int>(sizeof(plaintext))
-                          ? static_cast<size_t>(decLen)
-                          : sizeof(plaintext) - 1;
-  plaintext[clampIndex] = '\0';
-  const char *textPtr = reinterpret_cast<const char *>(&plaintext[5]);
-  size_t maxCopy = textBufferLen > 0 ? textBufferLen - 1 : 0;
-  size_t actualLen = strnlen(textPtr, MAX_MESSAGE_LEN - 1);
-  if (actualLen > maxCopy) {
-    actualLen = maxCopy;
+  if (!MeshCrypto::CryptoUtils::verifyMAC(channelKey, data, dataLen)) {
+    return false;
   }
-  if (textBufferLen > 0) {
-    memcpy(textBuffer, textPtr, actualLen);
-    textBuffer[actualLen] = '\0';
+
+  stream.key = &channelKey;
+  stream.cipher = data + CIPHER_MAC_SIZE;
+  stream.cipherLen = static_cast<uint8_t>(cipherLen);
+  stream.decrypted = 0;
+  stream.decryptNext();  // Timestamp, flags and the first 11 text bytes
+
+  TimeSync::updateFromRemote(stream.getTimestamp());
+  return true;
+}
+
+ChannelAnnouncer::MessageStream::MessageStream()
+    : key(nullptr), cipher(nullptr), cipherLen(0), decrypted(0) {
+  memset(plaintext, 0, sizeof(plaintext));
+}
+
+bool ChannelAnnouncer::MessageStream::decryptNext() {
+  if (isComplete()) {
+    return false;
   }
+  key->cipher.decryptBlock(&plaintext[decrypted], &cipher[decrypted]);
+  decrypted += CIPHER_BLOCK_SIZE;
+  plaintext[decrypted] = '\0';
   return true;
 }
 
+void ChannelAnnouncer::MessageStream::decryptAll() {
+  while (decryptNext()) {
+  }
+}
+
+uint32_t ChannelAnnouncer::MessageStream::getTimestamp() const {
+  uint32_t timestamp;
+  memcpy(&timestamp, plaintext, sizeof(timestamp));
+  return timestamp;
+}
+
+size_t ChannelAnnouncer::MessageStream::getTextLength() const {
+  return strnlen(getText(), MAX_MESSAGE_LEN - 1);
+}
+
+char ChannelAnnouncer::MessageStream::firstContentChar() {
+  while (true) {
+    const char *text = getText();
+    size_t length = getTextLength();
+    // The text is final once its NUL is decrypted or no blocks remain
+    bool ended = isComplete() || length + 5 < decrypted;
+
+    // Same rule as CommandHandler: content follows the first ':' and any spaces
+    const char *colon = static_cast<const char *>(memchr(text, ':', length));
+    if (colon != nullptr) {
+      const char *content = colon + 1;
+      while (content < text + length && *content == ' ') {
+        ++content;
+      }
+      if (content < text + length) {
+        return *content;
+      }
+    }
+    if (ended) {
+      return colon != nullptr ? '\0' : text[0];
+    }
+    decryptNext();
+  }
+}
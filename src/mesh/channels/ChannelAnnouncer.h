@@ -3,22 +3,75 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "../../core/PacketDecoder.h"
+#include "../../crypto/CryptoUtils.h"
 
 // Base class with shared channel functionality
 class ChannelAnnouncer {
 public:
   static constexpr size_t MAX_MESSAGE_LEN = 160;  // 10*CIPHER_BLOCK_SIZE, matches MeshCore
 
+  /**
+   * GRP_TXT plaintext decrypted on demand. The MAC over the whole
+   * ciphertext is checked when the stream is opened, then AES blocks are
+   * decrypted one at a time, so a reader that only needs the start of
+   * the text can stop early.
+   */
+  class MessageStream {
+  public:
+    MessageStream();
+
+    /**
+     * Decrypt the next block
+     *
+     * @return false once every block is decrypted
+     */
+    bool decryptNext();
+    void decryptAll();
+
+    /**
+     * Decrypt until the first character after the "name: " prefix is
+     * known (the text start if there is no prefix)
+     *
+     * @return That character, or '\0' if the message has no content
+     */
+    char firstContentChar();
+
+    bool isComplete() const { return decrypted >= cipherLen; }
+    uint32_t getTimestamp() const;
+
+    // Text decrypted so far, NUL terminated
+    const char *getText() const { return reinterpret_cast<const char *>(&plaintext[5]); }
+    size_t getTextLength() const;
+
+  private:
+    friend class ChannelAnnouncer;
+
+    // Timestamp, flags and text, padded to whole blocks
+    static constexpr size_t MAX_CIPHER_LEN =
+        (5 + MAX_MESSAGE_LEN + MeshCoreCompat::CIPHER_BLOCK_SIZE - 1) /
+        MeshCoreCompat::CIPHER_BLOCK_SIZE * MeshCoreCompat::CIPHER_BLOCK_SIZE;
+
+    const MeshCrypto::ChannelKey *key;
+    const uint8_t *cipher;
+    uint8_t cipherLen;
+    uint8_t decrypted;
+    uint8_t plaintext[MAX_CIPHER_LEN + 1];
+  };
+
 protected:
   // Shared packet building logic
   static bool buildPacketInternal(const char *text, uint8_t *rawPacket, uint16_t &length,
                                   uint32_t timestampSeconds,
-                                  const uint8_t *channelSecret, const uint8_t *channelHash);
-  
-  // Shared decoding logic  
-  static bool decodeMessageInternal(const MeshCore::DecodedPacket &packet, 
+                                  const MeshCrypto::ChannelKey &channelKey, const uint8_t *channelHash);
+
+  // Shared decoding logic
+  static bool decodeMessageInternal(const MeshCore::DecodedPacket &packet,
                                     uint32_t &timestamp, char *textBuffer,
                                     size_t textBufferLen,
-                                    const uint8_t *channelSecret, const uint8_t *channelHash);
-};
+                                    const MeshCrypto::ChannelKey &channelKey, const uint8_t *channelHash);
 
+  // Check hash and MAC, then decrypt only the first block into the stream
+  static bool openMessageInternal(const MeshCore::DecodedPacket &packet,
+                                  const MeshCrypto::ChannelKey &channelKey,
+                                  const uint8_t *channelHash, MessageStream &stream);
+};
@@ -5,7 +5,7 @@
 #include "../../core/Logger.h"
 #include "../../core/TimeSync.h"
 #include "../../crypto/CryptoUtils.h"
-#include "../../radio/LoRaTransmitter.h"
+#include "../../radio/TxScheduler.h"
 
 using namespace MeshCoreCompat;
 
@@ -14,22 +14,21 @@ PrivateChannelAnnouncer &PrivateChannelAnnouncer::getInstance() {
   return instance;
 }
 
-PrivateChannelAnnouncer::PrivateChannelAnnouncer() : numChannels(0) {
-  for (size_t i = 0; i < MAX_PRIVATE_CHANNELS; i++) {
-    memset(channels[i].secret, 0, sizeof(channels[i].secret));
+PrivateChannelAnnouncer::PrivateChannelAnnouncer() : keyUses(0) {
+  for (size_t i = 0; i < CHANNEL_COUNT; i++) {
     memset(channels[i].hash, 0, sizeof(channels[i].hash));
     channels[i].ready = false;
+    nextByHash[i] = NO_CHANNEL;
   }
+  for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+    keyCache[i].channel = NO_CHANNEL;
+    keyCache[i].lastUse = 0;
+  }
+  memset(firstByHash, NO_CHANNEL, sizeof(firstByHash));
 }
 
 void PrivateChannelAnnouncer::initialize() {
-  numChannels = Config::Channels::NUM_PRIVATE_CHANNELS;
-  if (numChannels > MAX_PRIVATE_CHANNELS) {
-    numChannels = MAX_PRIVATE_CHANNELS;
-    LOG_WARN_FMT("Too many private channels configured, limiting to %d", MAX_PRIVATE_CHANNELS);
-  }
-  
-  for (uint8_t ch = 0; ch < numChannels; ch++) {
+  for (uint8_t ch = 0; ch < CHANNEL_COUNT; ch++) {
     const char* hexKey = Config::Channels::PRIVATE_CHANNEL_KEYS[ch];
     
     // Decode hex string to bytes
@@ -40,44 +39,96 @@ void PrivateChannelAnnouncer::initialize() {
       continue;
     }
     
+    uint8_t *secret = channels[ch].secret;
     for (size_t i = 0; i < MeshCoreCompat::CIPHER_KEY_SIZE; i++) {
       char byte_str[3] = {hexKey[i*2], hexKey[i*2+1], '\0'};
-      channels[ch].secret[i] = (uint8_t)strtol(byte_str, nullptr, 16);
+      secret[i] = (uint8_t)strtol(byte_str, nullptr, 16);
     }
 
     MeshCrypto::CryptoUtils::sha256(channels[ch].hash, sizeof(channels[ch].hash),
-                                    channels[ch].secret, MeshCoreCompat::CIPHER_KEY_SIZE);
+                                    secret, sizeof(channels[ch].secret));
     channels[ch].ready = true;
     LOG_INFO_FMT("Initialized private channel %d", ch);
   }
+
+  // Index by hash byte, built backwards so each list runs in channel order
+  memset(firstByHash, NO_CHANNEL, sizeof(firstByHash));
+  for (size_t i = CHANNEL_COUNT; i > 0; i--) {
+    uint8_t ch = static_cast<uint8_t>(i - 1);
+    nextByHash[ch] = NO_CHANNEL;
+    if (channels[ch].ready) {
+      nextByHash[ch] = firstByHash[channels[ch].hash[0]];
+      firstByHash[channels[ch].hash[0]] = ch;
+    }
+  }
+
+  // Expand the first channels up front; with no more channels than cache
+  // entries nothing is expanded per packet
+  for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+    keyCache[i].channel = NO_CHANNEL;
+  }
+  for (uint8_t ch = 0; ch < KEY_CACHE_SIZE; ch++) {
+    if (channels[ch].ready) {
+      channelKey(ch);
+    }
+  }
+}
+
+const MeshCrypto::ChannelKey &PrivateChannelAnnouncer::channelKey(uint8_t channelIndex) {
+  keyUses++;
+  CachedKey *victim = &keyCache[0];
+  for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+    CachedKey &entry = keyCache[i];
+    if (entry.channel == channelIndex) {
+      entry.lastUse = keyUses;
+      return entry.key;
+    }
+    // Free entries first, then the one unused the longest
+    if (victim->channel != NO_CHANNEL &&
+        (entry.channel == NO_CHANNEL ||
+         keyUses - entry.lastUse > keyUses - victim->lastUse)) {
+      victim = &entry;
+    }
+  }
+
+  victim->key.setKey(channels[channelIndex].secret,
+                     sizeof(channels[channelIndex].secret));
+  victim->channel = channelIndex;
+  victim->lastUse = keyUses;
+  return victim->key;
 }
 
 bool PrivateChannelAnnouncer::buildPacket(const char *text, uint8_t *rawPacket,
                                          uint16_t &length,
                                          uint32_t timestampSeconds,
                                          uint8_t channelIndex) {
-  if (channelIndex >= numChannels || !channels[channelIndex].ready) {
+  if (channelIndex >= CHANNEL_COUNT || !channels[channelIndex].ready) {
     return false;
   }
   return buildPacketInternal(text, rawPacket, length, timestampSeconds,
-                             channels[channelIndex].secret, channels[channelIndex].hash);
+                             channelKey(channelIndex), channels[channelIndex].hash);
 }
 
 bool PrivateChannelAnnouncer::sendText(const char *text,
                                       uint32_t timestampSeconds,
                                       uint8_t channelIndex) {
-  if (channelIndex >= numChannels || !channels[channelIndex].ready) {
+  if (channelIndex >= CHANNEL_COUNT || !channels[channelIndex].ready) {
+    return false;
+  }
+
+  auto &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *raw = scheduler.acquire(handle);
+  if (raw == nullptr) {
     return false;
   }
 
-  uint8_t raw[Config::Forwarding::MAX_ENCODED_PACKET_SIZE];
   uint16_t len = 0;
   if (!buildPacket(text, raw, len, timestampSeconds, channelIndex)) {
+    scheduler.discard(handle);
     return false;
   }
-
-  auto &tx = LoRaTransmitter::getInstance();
-  return tx.transmit(raw, len);
+  return scheduler.submit(handle, len, 0);
 }
 
 bool PrivateChannelAnnouncer::decodeMessage(
@@ -92,15 +143,11 @@ bool PrivateChannelAnnouncer::decodeMessage(
     return false;
   }
 
-  // Try all configured channels
-  for (uint8_t ch = 0; ch < numChannels; ch++) {
-    if (!channels[ch].ready) {
-      continue;
-    }
-
-    // Try to decode with this channel
+  // Only channels whose hash byte matches can decode it
+  for (uint8_t ch = firstByHash[packet.payload[0]]; ch != NO_CHANNEL;
+       ch = nextByHash[ch]) {
     if (decodeMessageInternal(packet, timestamp, textBuffer, textBufferLen,
-                              channels[ch].secret, channels[ch].hash)) {
+                              channelKey(ch), channels[ch].hash)) {
       channelIndex = ch;
       return true;
     }
@@ -109,3 +156,21 @@ bool PrivateChannelAnnouncer::decodeMessage(
   return false;  // No channel matched
 }
 
+bool PrivateChannelAnnouncer::openMessage(const MeshCore::DecodedPacket &packet,
+                                          MessageStream &stream,
+                                          uint8_t &channelIndex) {
+  if (packet.payloadType != MeshCore::PayloadType::GRP_TXT ||
+      packet.payloadLength == 0) {
+    return false;
+  }
+
+  for (uint8_t ch = firstByHash[packet.payload[0]]; ch != NO_CHANNEL;
+       ch = nextByHash[ch]) {
+    if (openMessageInternal(packet, channelKey(ch), channels[ch].hash, stream)) {
+      channelIndex = ch;
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include "../MeshCrypto.h"
+#include "../../core/Config.h"
 #include "../../core/PacketDecoder.h"
 #include "ChannelAnnouncer.h"
 
@@ -13,21 +14,54 @@ public:
   bool sendText(const char *text, uint32_t timestampSeconds, uint8_t channelIndex = 0);
   bool decodeMessage(const MeshCore::DecodedPacket &packet, uint32_t &timestamp,
                      char *textBuffer, size_t textBufferLen, uint8_t &channelIndex);
+  // MAC-checked message with only its first block decrypted; the stream
+  // reads a cached key, so finish with it before the next channel lookup
+  bool openMessage(const MeshCore::DecodedPacket &packet, MessageStream &stream,
+                   uint8_t &channelIndex);
   bool buildPacket(const char *text, uint8_t *rawPacket, uint16_t &length,
                    uint32_t timestampSeconds, uint8_t channelIndex = 0);
-  uint8_t getNumChannels() const { return numChannels; }
-  static constexpr size_t MAX_PRIVATE_CHANNELS = 8;
+  uint8_t getNumChannels() const { return CHANNEL_COUNT; }
+  static constexpr size_t MAX_PRIVATE_CHANNELS = 128;
 
 private:
   PrivateChannelAnnouncer();
 
+  // Table sized to the configured keys; each entry keeps only the secret
+  static constexpr size_t CHANNEL_COUNT = Config::Channels::NUM_PRIVATE_CHANNELS;
+  static constexpr uint8_t NO_CHANNEL = 0xFF;
+  static_assert(CHANNEL_COUNT <= MAX_PRIVATE_CHANNELS,
+                "Too many private channels configured");
+  static_assert(Config::Channels::KEY_CACHE_SIZE > 0,
+                "KEY_CACHE_SIZE must hold at least one key");
+
+  static constexpr size_t KEY_CACHE_SIZE =
+      CHANNEL_COUNT < Config::Channels::KEY_CACHE_SIZE
+          ? CHANNEL_COUNT
+          : Config::Channels::KEY_CACHE_SIZE;
+
   struct ChannelData {
-    uint8_t secret[MeshCoreCompat::PUB_KEY_SIZE];
+    uint8_t secret[MeshCoreCompat::CIPHER_KEY_SIZE];
     uint8_t hash[MeshCoreCompat::PATH_HASH_SIZE];
     bool ready;
   };
 
-  ChannelData channels[MAX_PRIVATE_CHANNELS];
-  uint8_t numChannels;
-};
+  // Expanded round keys and HMAC pads of a recently used channel
+  struct CachedKey {
+    MeshCrypto::ChannelKey key;
+    uint32_t lastUse;  // keyUses when last returned
+    uint8_t channel;   // NO_CHANNEL while unused
+  };
 
+  ChannelData channels[CHANNEL_COUNT];
+  CachedKey keyCache[KEY_CACHE_SIZE];
+  uint32_t keyUses;
+
+  // Channels by first hash byte: head of a list chained through nextByHash,
+  // so a GRP_TXT only tries the channels whose hash byte matches
+  uint8_t firstByHash[256];
+  uint8_t nextByHash[CHANNEL_COUNT];
+
+  // Expanded key for a ready channel, expanding it into the least recently
+  // used cache entry on a miss. Valid until the next call.
+  const MeshCrypto::ChannelKey &channelKey(uint8_t channelIndex);
+};
@@ -7,15 +7,18 @@
 #include "../../core/HashUtils.h"
 #include "../../core/Logger.h"
 #include "../../core/NodeConfig.h"
+#include "../../core/Profiler.h"
 #include "../../core/TimeSync.h"
 #include "../../core/Config.h"
 #include "../../core/CryptoIdentity.h"
 #include "../../power/PowerManager.h"
 #include "../../radio/LoRaReceiver.h"
 #include "../../radio/LoRaTransmitter.h"
+#include "../../radio/TxScheduler.h"
 #include "../channels/PrivateChannelAnnouncer.h"
 #include "../channels/ChannelAnnouncer.h"
 #include "../NeighborTracker.h"
+#include "PacketForwarder.h"
 #include "../../lib/ed25519/ed_25519.h"
 
 using MeshCore::PayloadType;
@@ -32,17 +35,26 @@ CommandHandler::processPacket(const MeshCore::PacketEvent &event,
     return MeshCore::ProcessResult::CONTINUE;
   }
 
-  uint32_t msgTimestamp = 0;
-  char text[ChannelAnnouncer::MAX_MESSAGE_LEN];
+  ChannelAnnouncer::MessageStream message;
   uint8_t privateChannelIndex = 0;
   
   // Only allow commands in private channels
-  if (!PrivateChannelAnnouncer::getInstance().decodeMessage(event.packet,
-                                                            msgTimestamp, text,
-                                                            sizeof(text),
-                                                            privateChannelIndex)) {
+  if (!PrivateChannelAnnouncer::getInstance().openMessage(event.packet, message,
+                                                          privateChannelIndex)) {
+    return MeshCore::ProcessResult::CONTINUE;
+  }
+
+  // Most channel traffic is chat: stop decrypting once the first character
+  // after the sender prefix rules out a command
+  if (message.firstContentChar() != '!') {
     return MeshCore::ProcessResult::CONTINUE;
   }
+  message.decryptAll();
+
+  char text[ChannelAnnouncer::MAX_MESSAGE_LEN];
+  size_t textLen = message.getTextLength();
+  memcpy(text, message.getText(), textLen);
+  text[textLen] = '\0';
 
   // Extract command (skip username prefix if present)
   const char *content = text;
@@ -125,9 +137,10 @@ CommandHandler::processPacket(const MeshCore::PacketEvent &event,
     return MeshCore::ProcessResult::CONTINUE;
   }
 
-  // Rate limiting: only respond once per minute
+  // Rate limiting: one response in flight, and one sent per minute
   uint32_t now = millis();
-  if (lastResponseTime != 0 && (now - lastResponseTime) < RESPONSE_RATE_LIMIT_MS) {
+  if (responsePending ||
+      (lastResponseTime != 0 && (now - lastResponseTime) < RESPONSE_RATE_LIMIT_MS)) {
     return MeshCore::ProcessResult::CONTINUE;
   }
 
@@ -151,6 +164,10 @@ CommandHandler::processPacket(const MeshCore::PacketEvent &event,
     handled = handleNeighborsCommand(privateChannelIndex);
   } else if (strcmp(cmd, "!help") == 0) {
     handled = handleHelpCommand(privateChannelIndex);
+#ifdef ENABLE_PROFILING
+  } else if (strcmp(cmd, "!perf") == 0) {
+    handled = handlePerfCommand(args, privateChannelIndex);
+#endif
   }
   
   if (handled) {
@@ -170,6 +187,9 @@ bool CommandHandler::handleStatusCommand(const char *args, uint8_t privateChanne
     PowerManager::getInstance().resetStats();
     LoRaReceiver::resetStats();
     LoRaTransmitter::getInstance().resetStats();
+    if (forwarder != nullptr) {
+      forwarder->resetClassStats();
+    }
     
     snprintf(message, sizeof(message), "%s %02X: Stats cleared", 
              Config::Identity::NODE_NAME, nodeHash);
@@ -181,42 +201,53 @@ bool CommandHandler::handleStatusCommand(const char *args, uint8_t privateChanne
     uint32_t txAirtime = LoRaTransmitter::getInstance().getTotalAirtimeMs();
     uint32_t totalAirtime = rxAirtime + txAirtime;
     uint32_t airtimeSec = totalAirtime / 1000;
+    uint16_t dutyPermille =
+        LoRaTransmitter::getInstance().getDutyCycle().getUsagePermille(millis());
     
-    snprintf(message, sizeof(message), "%s %02X: RX:%lu TX:%lu Air:%lus", 
-             Config::Identity::NODE_NAME, nodeHash, rxPackets, txPackets, 
-             airtimeSec);
+    int offset = snprintf(message, sizeof(message), "%s %02X: RX:%lu TX:%lu Air:%lus DC:%u.%u%%", 
+                          Config::Identity::NODE_NAME, nodeHash,
+                          (unsigned long)rxPackets, (unsigned long)txPackets,
+                          (unsigned long)airtimeSec, dutyPermille / 10, dutyPermille % 10);
+
+    // Forward queue per class as enqueued/evicted/transmitted, e.g. H:3/0/3
+    static const char CLASS_LABELS[] = "HML";
+    for (uint8_t i = 0; i < MeshCore::TRAFFIC_CLASS_COUNT && forwarder != nullptr &&
+                        offset > 0 && offset < (int)sizeof(message); ++i) {
+      const MeshCore::ForwardClassStats &stats =
+          forwarder->getClassStats(static_cast<MeshCore::TrafficClass>(i));
+      offset += snprintf(&message[offset], sizeof(message) - offset, " %c:%lu/%lu/%lu",
+                         CLASS_LABELS[i], (unsigned long)stats.enqueued,
+                         (unsigned long)stats.evicted, (unsigned long)stats.transmitted);
+    }
   }
 
-  uint32_t timestamp = TimeSync::now();
-  bool buildSuccess = PrivateChannelAnnouncer::getInstance().buildPacket(message, pendingPacket, 
-                                                                          pendingPacketLength, timestamp,
-                                                                          privateChannelIndex);
-  
-  if (!buildSuccess) {
+  if (!queueTextResponse(message, privateChannelIndex)) {
     LOG_WARN("Failed to build status response");
     return false;
   }
   
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
-  
   LOG_INFO("Queued !status response");
   return true;
 }
 
 bool CommandHandler::handleAdvertCommand(uint8_t privateChannelIndex) {
-  // Build advert packet
-  if (!buildAdvertPacket(pendingPacket, pendingPacketLength)) {
+  // Build advert packet straight into the TX queue
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *frame = scheduler.acquire(handle);
+  uint16_t length = 0;
+  if (frame == nullptr || !buildAdvertPacket(frame, length)) {
     LOG_WARN("Failed to build advert packet");
+    scheduler.discard(handle);
     return false;
   }
 
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
+  if (!queueResponse(handle, length)) {
+    LOG_WARN("Failed to queue advert packet");
+    return false;
+  }
   
-  LOG_INFO_FMT("Queued !advert response (%u bytes)", pendingPacketLength);
+  LOG_INFO_FMT("Queued !advert response (%u bytes)", length);
   return true;
 }
 
@@ -261,20 +292,11 @@ bool CommandHandler::handleLocationCommand(const char *args, uint8_t privateChan
     }
   }
   
-  uint32_t timestamp = TimeSync::now();
-  bool buildSuccess = PrivateChannelAnnouncer::getInstance().buildPacket(message, pendingPacket, 
-                                                                          pendingPacketLength, timestamp,
-                                                                          privateChannelIndex);
-  
-  if (!buildSuccess) {
+  if (!queueTextResponse(message, privateChannelIndex)) {
     LOG_WARN("Failed to build location response");
     return false;
   }
   
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
-  
   LOG_INFO("Queued !location response");
   return true;
 }
@@ -294,20 +316,11 @@ bool CommandHandler::handleNeighborsCommand(uint8_t privateChannelIndex) {
                                                      sizeof(message) - offset);
   }
   
-  uint32_t timestamp = TimeSync::now();
-  bool buildSuccess = PrivateChannelAnnouncer::getInstance().buildPacket(message, pendingPacket, 
-                                                                          pendingPacketLength, timestamp,
-                                                                          privateChannelIndex);
-  
-  if (!buildSuccess) {
+  if (!queueTextResponse(message, privateChannelIndex)) {
     LOG_WARN("Failed to build neighbors response");
     return false;
   }
   
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
-  
   LOG_INFO("Queued !neighbors response");
   return true;
 }
@@ -318,51 +331,84 @@ bool CommandHandler::handleHelpCommand(uint8_t privateChannelIndex) {
   
   // Clear hierarchical format (under 160 chars)
   snprintf(message, sizeof(message), 
-           "%s %02X: !cmd[@XX] | !status[clear] !location[lat lon|clear] !neighbors !advert !help", 
+           "%s %02X: !cmd[@XX] | !status[clear] !location[lat lon|clear] !neighbors !advert"
+#ifdef ENABLE_PROFILING
+           " !perf[clear]"
+#endif
+           " !help", 
            Config::Identity::NODE_NAME, nodeHash);
   
-  uint32_t timestamp = TimeSync::now();
-  bool buildSuccess = PrivateChannelAnnouncer::getInstance().buildPacket(message, pendingPacket, 
-                                                                          pendingPacketLength, timestamp,
-                                                                          privateChannelIndex);
-  
-  if (!buildSuccess) {
+  if (!queueTextResponse(message, privateChannelIndex)) {
     LOG_WARN("Failed to build help response");
     return false;
   }
   
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
-  
   LOG_INFO("Queued !help response");
   return true;
 }
 
-void CommandHandler::loop() {
-  if (!pendingResponse) {
-    return;
+#ifdef ENABLE_PROFILING
+bool CommandHandler::handlePerfCommand(const char *args, uint8_t privateChannelIndex) {
+  uint8_t nodeHash = MeshCore::NodeConfig::getInstance().getNodeHash();
+  char message[ChannelAnnouncer::MAX_MESSAGE_LEN];
+  Profiler &profiler = Profiler::getInstance();
+
+  if (args && strcmp(args, "clear") == 0) {
+    profiler.reset();
+    snprintf(message, sizeof(message), "%s %02X: Perf cleared",
+             Config::Identity::NODE_NAME, nodeHash);
+  } else {
+    // avg/max us per stage; the full table goes to serial
+    profiler.logReport();
+    int prefix = snprintf(message, sizeof(message), "%s %02X: ",
+                          Config::Identity::NODE_NAME, nodeHash);
+    if (prefix > 0 && static_cast<size_t>(prefix) < sizeof(message)) {
+      profiler.formatSummary(message + prefix, sizeof(message) - prefix);
+    }
+  }
+
+  if (!queueTextResponse(message, privateChannelIndex)) {
+    LOG_WARN("Failed to build perf response");
+    return false;
   }
   
-  if (millis() >= responseTime) {
-    auto &tx = LoRaTransmitter::getInstance();
-    if (tx.isTransmitting()) {
-      uint32_t airtime = LoRaTransmitter::estimateAirtime(pendingPacketLength);
-      uint32_t retryDelay = static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
-      responseTime = millis() + retryDelay;
-      return;
-    }
-    
-    if (!tx.transmit(pendingPacket, pendingPacketLength)) {
-      uint32_t airtime = LoRaTransmitter::estimateAirtime(pendingPacketLength);
-      uint32_t retryDelay = static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
-      responseTime = millis() + retryDelay;
-      return;
-    }
-    
-    lastResponseTime = millis();
-    pendingResponse = false;
+  LOG_INFO("Queued !perf response");
+  return true;
+}
+#endif
+
+bool CommandHandler::queueTextResponse(const char *message,
+                                       uint8_t privateChannelIndex) {
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *frame = scheduler.acquire(handle);
+  if (frame == nullptr) {
+    return false;
+  }
+
+  uint16_t length = 0;
+  if (!PrivateChannelAnnouncer::getInstance().buildPacket(
+          message, frame, length, TimeSync::now(), privateChannelIndex)) {
+    scheduler.discard(handle);
+    return false;
+  }
+  return queueResponse(handle, length);
+}
+
+bool CommandHandler::queueResponse(uint8_t handle, uint16_t length) {
+  uint32_t jitter = calculateResponseDelay(length);
+  // Set first: a due frame is sent, and reported, from within submit
+  responsePending = true;
+  if (!TxScheduler::getInstance().submit(handle, length, jitter, this)) {
+    responsePending = false;
+    return false;
   }
+  return true;
+}
+
+void CommandHandler::onFrameSent() {
+  responsePending = false;
+  lastResponseTime = millis();
 }
 
 uint32_t CommandHandler::calculateResponseDelay(uint16_t packetLength) const {
@@ -462,7 +508,7 @@ bool CommandHandler::buildAdvertPacket(uint8_t *dest, uint16_t &length) {
   
   ed25519_sign(signaturePtr, message, messageLen, publicKey, privateKey);
   
-  length = MeshCore::PacketDecoder::encode(packet, dest, 256);
+  length = MeshCore::PacketDecoder::encode(packet, dest, Config::Forwarding::MAX_ENCODED_PACKET_SIZE);
   
   if (length == 0) {
     LOG_ERROR("Failed to encode advert packet");
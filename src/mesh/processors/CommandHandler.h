@@ -3,6 +3,11 @@
 #include <stdint.h>
 #include "../../core/PacketDecoder.h"
 #include "../PacketDispatcher.h"
+#include "../../radio/TxScheduler.h"
+
+namespace MeshCore {
+class PacketForwarder;
+}
 
 /**
  * CommandHandler - Unified handler for all private channel text commands
@@ -10,18 +15,30 @@
  * Handles: !status, !clear, !advert, !location
  * Consolidates duplicate code from Status and AdvertResponders to save flash space.
  */
-class CommandHandler : public MeshCore::IPacketProcessor {
+class CommandHandler : public MeshCore::IPacketProcessor, public ITxListener {
 public:
   CommandHandler() : lastPayloadHash(0), lastPayloadTime(0), lastResponseTime(0), 
-                     pendingResponse(false), responseTime(0) {}
+                     responsePending(false), forwarder(nullptr) {}
 
   MeshCore::ProcessResult processPacket(const MeshCore::PacketEvent &event,
                               MeshCore::ProcessingContext &ctx) override;
   const char *getName() const override { return "CommandHandler"; }
-  uint8_t getPriority() const override { return 35; }  // After forwarding, before logging
-  
-  void loop();
-  bool hasPendingResponse() const { return pendingResponse; }
+  static constexpr uint8_t PRIORITY = 35;  // After forwarding, before logging
+  uint8_t getPriority() const override { return PRIORITY; }
+  MeshCore::PacketInterest getInterest() const override {
+    return MeshCore::PacketInterest::only(
+        MeshCore::PacketInterest::payload(MeshCore::PayloadType::GRP_TXT));
+  }
+
+  // Adds the forwarder's delay queue counters to !status
+  void setForwarder(MeshCore::PacketForwarder *packetForwarder) {
+    forwarder = packetForwarder;
+  }
+
+  // The rate limit runs from when a response goes on air; one the
+  // scheduler drops does not count
+  void onFrameSent() override;
+  void onFrameDropped() override { responsePending = false; }
 
 private:
   static constexpr uint32_t RESPONSE_RATE_LIMIT_MS = 60000; // 1 minute
@@ -29,14 +46,16 @@ private:
 
   uint32_t lastPayloadHash;
   uint32_t lastPayloadTime;
-  uint32_t lastResponseTime;
-  bool pendingResponse;
-  uint32_t responseTime;
-  uint8_t pendingPacket[256]; // Pre-encoded packet
-  uint16_t pendingPacketLength;
+  uint32_t lastResponseTime;  // millis() when the last response was sent
+  bool responsePending;       // Queued in the TxScheduler, not sent yet
+  MeshCore::PacketForwarder *forwarder;
 
   static uint32_t hashPayload(const MeshCore::DecodedPacket &packet);
   uint32_t calculateResponseDelay(uint16_t packetLength) const;
+
+  // Responses are encoded into the TxScheduler pool and sent after jitter
+  bool queueTextResponse(const char *message, uint8_t privateChannelIndex);
+  bool queueResponse(uint8_t handle, uint16_t length);
   
   // Command handlers
   bool handleStatusCommand(const char *args, uint8_t privateChannelIndex);
@@ -44,6 +63,9 @@ private:
   bool handleLocationCommand(const char *args, uint8_t privateChannelIndex);
   bool handleNeighborsCommand(uint8_t privateChannelIndex);
   bool handleHelpCommand(uint8_t privateChannelIndex);
+#ifdef ENABLE_PROFILING
+  bool handlePerfCommand(const char *args, uint8_t privateChannelIndex);
+#endif
   
   // Helper for advert
   bool buildAdvertPacket(uint8_t *dest, uint16_t &length);
@@ -5,27 +5,60 @@
 
 namespace MeshCore {
 
-Deduplicator::Deduplicator() : duplicateCount(0) { resetCache(); }
+Deduplicator::Deduplicator() : duplicateCount(0), duplicateListener(nullptr) {
+  resetCache();
+}
 
 void Deduplicator::resetCache() {
   cache.clear();
   duplicateCount = 0;
 }
 
-uint32_t Deduplicator::computePacketHash(const DecodedPacket &packet) {
-  uint8_t payloadType = static_cast<uint8_t>(packet.payloadType);
-  uint32_t hash = HashUtils::fnv1aWithBytes(packet.payload, packet.payloadLength,
-                                            payloadType, packet.payloadVersion);
+uint32_t Deduplicator::hashFields(PayloadType payloadType,
+                                  uint8_t payloadVersion, RouteType routeType,
+                                  uint8_t pathLength, const uint8_t *payload,
+                                  uint16_t payloadLength) {
+  uint32_t hash = HashUtils::fnv1aWithBytes(payload, payloadLength,
+                                            static_cast<uint8_t>(payloadType),
+                                            payloadVersion);
 
-  if (packet.payloadType == PayloadType::TRACE &&
-      packet.routeType == RouteType::DIRECT) {
-    hash ^= packet.pathLength;
+  if (payloadType == PayloadType::TRACE && routeType == RouteType::DIRECT) {
+    hash ^= pathLength;
     hash *= HashUtils::FNV_PRIME;
   }
 
   return hash;
 }
 
+uint32_t Deduplicator::computePacketHash(const DecodedPacket &packet) {
+  return hashFields(packet.payloadType, packet.payloadVersion,
+                    packet.routeType, packet.pathLength, packet.payload,
+                    packet.payloadLength);
+}
+
+uint32_t Deduplicator::computeFrameHash(const uint8_t *raw,
+                                        const FrameLayout &layout) {
+  return hashFields(layout.payloadType, layout.payloadVersion,
+                    layout.routeType, layout.pathLength,
+                    raw + layout.payloadOffset, layout.payloadLength);
+}
+
+bool Deduplicator::checkFrame(uint32_t hash, uint32_t timestamp) {
+  if (!isDuplicate(hash, timestamp)) {
+    return false;
+  }
+  reportDuplicate(hash);
+  return true;
+}
+
+void Deduplicator::reportDuplicate(uint32_t hash) {
+  duplicateCount++;
+  LOG_INFO_FMT(">>> DUPLICATE DETECTED: hash=0x%08lX <<<", hash);
+  if (duplicateListener != nullptr) {
+    duplicateListener->onDuplicate(hash);
+  }
+}
+
 uint16_t Deduplicator::extractSourceNode(const DecodedPacket &packet) const {
   if (packet.hasTransportCodes) {
     LOG_DEBUG_FMT("Source from transport[0]: %u", packet.transportCodes[0]);
@@ -43,53 +76,15 @@ uint16_t Deduplicator::extractSourceNode(const DecodedPacket &packet) const {
 }
 
 bool Deduplicator::isDuplicate(uint32_t hash, uint32_t timestamp) {
-  bool found = false;
-
-  cache.forEach([&](PacketHash &entry, size_t index) {
-    if (!entry.valid) {
-      return true; // Continue iteration
-    }
-
-    // Check if expired
-    if (timestamp - entry.timestamp > CACHE_TIMEOUT_MS) {
-      entry.valid = false;
-      return true; // Continue
-    }
-
-    // Check for match
-    if (entry.hash == hash) {
-      found = true;
-      return false; // Stop iteration
-    }
-
-    return true; // Continue
-  });
-
-  return found;
+  return cache.contains(hash, timestamp);
 }
 
 void Deduplicator::addToCache(uint32_t hash, uint32_t timestamp) {
-  PacketHash newEntry;
-  newEntry.hash = hash;
-  newEntry.timestamp = timestamp;
-  newEntry.valid = true;
-
-  cache.push(newEntry);
-}
-
-void Deduplicator::cleanExpiredEntries(uint32_t currentTime) {
-  cache.forEach([&](PacketHash &entry, size_t index) {
-    if (entry.valid && (currentTime - entry.timestamp > CACHE_TIMEOUT_MS)) {
-      entry.valid = false;
-    }
-    return true; // Continue iteration
-  });
+  cache.insert(hash, timestamp);
 }
 
 ProcessResult Deduplicator::processPacket(const PacketEvent &event,
                                           ProcessingContext &ctx) {
-  cleanExpiredEntries(event.timestamp);
-
   uint32_t hash = computePacketHash(event.packet);
 
   LOG_INFO_FMT("Packet hash: 0x%08lX (%s/%s, payload=%d bytes)", hash,
@@ -97,15 +92,16 @@ ProcessResult Deduplicator::processPacket(const PacketEvent &event,
                PacketDecoder::payloadTypeToString(event.packet.payloadType),
                event.packet.payloadLength);
 
-  if (isDuplicate(hash, event.timestamp)) {
-    ctx.isDuplicate = true;
-    duplicateCount++;
-    LOG_INFO_FMT(">>> DUPLICATE DETECTED: hash=0x%08lX <<<", hash);
-    return ProcessResult::DROP;
+  // Frames cached by the RX filter had their copies rejected there
+  if (!event.cachedOnReceive) {
+    if (isDuplicate(hash, event.timestamp)) {
+      ctx.isDuplicate = true;
+      reportDuplicate(hash);
+      return ProcessResult::DROP;
+    }
+    addToCache(hash, event.timestamp);
   }
 
-  addToCache(hash, event.timestamp);
-
   ctx.sourceNode = extractSourceNode(event.packet);
 
   // Store hash in event for other processors to use (hash is mutable)
@@ -2,14 +2,51 @@
 
 #include "../../core/Config.h"
 #include "../../core/Logger.h"
-#include "../../core/containers/CircularBuffer.h"
+#include "../../core/containers/ExpiringHashSet.h"
+#include "../../core/containers/TimedBloomFilter.h"
 #include "../PacketDispatcher.h"
 
 namespace MeshCore {
 
+/**
+ * Notified when the Deduplicator drops a packet it has already seen.
+ */
+class IDuplicateListener {
+public:
+  virtual ~IDuplicateListener() = default;
+  virtual void onDuplicate(uint32_t hash) = 0;
+};
+
+/**
+ * Seen-packet cache type for a Config::Deduplication::Backend.
+ */
+template <Config::Deduplication::Backend B> struct DedupCache;
+
+template <> struct DedupCache<Config::Deduplication::Backend::HASH_SET> {
+  typedef ExpiringHashSet<Config::Deduplication::CACHE_SIZE,
+                          Config::Deduplication::CACHE_TIMEOUT_MS>
+      Type;
+  static constexpr bool CAN_ERASE = true;
+  static void erase(Type &cache, uint32_t hash, uint32_t now) {
+    cache.erase(hash, now);
+  }
+};
+
+template <> struct DedupCache<Config::Deduplication::Backend::BLOOM_FILTER> {
+  typedef TimedBloomFilter<Config::Deduplication::BLOOM_FILTER_BITS,
+                           Config::Deduplication::BLOOM_FILTER_HASHES,
+                           Config::Deduplication::CACHE_TIMEOUT_MS>
+      Type;
+  // Bits are shared between hashes, so one cannot be taken back
+  static constexpr bool CAN_ERASE = false;
+  static void erase(Type &, uint32_t, uint32_t) {}
+};
+
 /**
  * Deduplicator prevents forwarding the same packet multiple times.
- * Uses a circular buffer cache with time-based expiration.
+ * The seen-packet cache is selected at compile time: an exact
+ * open-addressing hash set or a two-generation Bloom filter, both with
+ * time-based expiration.
  */
 class Deduplicator : public IPacketProcessor {
 public:
@@ -19,33 +56,59 @@ public:
   ProcessResult processPacket(const PacketEvent &event,
                               ProcessingContext &ctx) override;
   const char *getName() const override { return "Deduplicator"; }
-  uint8_t getPriority() const override { return 10; }
+  static constexpr uint8_t PRIORITY = 10;
+  uint8_t getPriority() const override { return PRIORITY; }
 
   void resetCache();
   uint32_t getDuplicateCount() const { return duplicateCount; }
+  void setDuplicateListener(IDuplicateListener *listener) {
+    duplicateListener = listener;
+  }
 
   static uint32_t computePacketHash(const DecodedPacket &packet);
+  // Same hash as computePacketHash, straight from the received bytes
+  static uint32_t computeFrameHash(const uint8_t *raw, const FrameLayout &layout);
 
-private:
-  struct PacketHash {
-    uint32_t hash;
-    uint32_t timestamp;
-    bool valid;
+  /**
+   * Duplicate check for frames that have not been decoded yet (see
+   * RxPrefilter). Counts and reports a hit like processPacket does.
+   */
+  bool checkFrame(uint32_t hash, uint32_t timestamp);
+
+  /**
+   * Cache the hash of a queued frame ahead of dispatch. processPacket
+   * then skips the lookup for events marked cachedOnReceive, since it
+   * would find this entry.
+   */
+  void recordFrame(uint32_t hash, uint32_t timestamp) {
+    addToCache(hash, timestamp);
+  }
 
-    PacketHash() : hash(0), timestamp(0), valid(false) {}
-  };
+  /**
+   * Undo recordFrame for a frame that was dropped before dispatch, so
+   * its copies are not rejected. Only possible with CAN_FORGET.
+   */
+  void forgetFrame(uint32_t hash, uint32_t timestamp) {
+    DedupCache<Config::Deduplication::BACKEND>::erase(cache, hash, timestamp);
+  }
+  static constexpr bool CAN_FORGET =
+      DedupCache<Config::Deduplication::BACKEND>::CAN_ERASE;
 
-  static constexpr size_t CACHE_SIZE = Config::Deduplication::CACHE_SIZE;
-  static constexpr uint32_t CACHE_TIMEOUT_MS =
-      Config::Deduplication::CACHE_TIMEOUT_MS;
+  typedef DedupCache<Config::Deduplication::BACKEND>::Type Cache;
+  const Cache &getCache() const { return cache; }
 
-  CircularBuffer<PacketHash, CACHE_SIZE> cache;
+private:
+  Cache cache;
   uint32_t duplicateCount;
+  IDuplicateListener *duplicateListener;
 
-  bool isDuplicate(uint32_t hash, uint32_t timestamp);  // Not const - modifies cache
+  bool isDuplicate(uint32_t hash, uint32_t timestamp);  // Not const - Bloom rotates
   void addToCache(uint32_t hash, uint32_t timestamp);
-  void cleanExpiredEntries(uint32_t currentTime);
   uint16_t extractSourceNode(const DecodedPacket &packet) const;
+  void reportDuplicate(uint32_t hash);
+  static uint32_t hashFields(PayloadType payloadType, uint8_t payloadVersion,
+                             RouteType routeType, uint8_t pathLength,
+                             const uint8_t *payload, uint16_t payloadLength);
 };
 
 } // namespace MeshCore
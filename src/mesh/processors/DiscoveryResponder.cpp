@@ -2,6 +2,7 @@
 #include "../../core/CryptoIdentity.h"
 #include "../../core/NodeConfig.h"
 #include "../../radio/LoRaTransmitter.h"
+#include "../../radio/TxScheduler.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -111,58 +112,33 @@ ProcessResult DiscoveryResponder::processPacket(const PacketEvent &event,
   lastRequestTag = tag;
   lastRequestTime = now;
 
-  // Build discovery response
-  if (!buildDiscoveryResponse(event.packet.payload, event.packet.payloadLength,
-                              event.snr, pendingPacket, pendingPacketLength)) {
+  // Build discovery response straight into the TX queue
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *frame = scheduler.acquire(handle);
+  uint16_t length = 0;
+  if (frame == nullptr ||
+      !buildDiscoveryResponse(event.packet.payload, event.packet.payloadLength,
+                              event.snr, frame, length)) {
     LOG_WARN("Failed to build DISCOVER_RESP");
+    scheduler.discard(handle);
     return ProcessResult::CONTINUE;
   }
 
   // Calculate jitter-based delay
-  uint32_t jitter = calculateResponseDelay(pendingPacketLength);
-  pendingResponse = true;
-  responseTime = millis() + jitter;
+  uint32_t jitter = calculateResponseDelay(length);
+  if (!scheduler.submit(handle, length, jitter)) {
+    LOG_WARN("Failed to queue DISCOVER_RESP");
+    return ProcessResult::CONTINUE;
+  }
+  lastResponseTime = now;
 
   LOG_INFO_FMT("Queued DISCOVER_RESP (%u bytes) with %lu ms jitter, tag=0x%08lX",
-               pendingPacketLength, jitter, tag);
+               length, jitter, tag);
 
   return ProcessResult::CONTINUE;
 }
 
-void DiscoveryResponder::loop() {
-  if (!pendingResponse) {
-    return;
-  }
-
-  if (millis() >= responseTime) {
-    // Check if transmitter is available
-    auto &tx = LoRaTransmitter::getInstance();
-    if (tx.isTransmitting()) {
-      // Transmitter busy, retry after one airtime slot
-      uint32_t airtime = LoRaTransmitter::estimateAirtime(pendingPacketLength);
-      uint32_t retryDelay =
-          static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
-      responseTime = millis() + retryDelay;
-      return;
-    }
-
-    // Try to transmit
-    if (!tx.transmit(pendingPacket, pendingPacketLength)) {
-      // Failed (likely duty cycle / airtime budget)
-      uint32_t airtime = LoRaTransmitter::estimateAirtime(pendingPacketLength);
-      uint32_t retryDelay =
-          static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
-      responseTime = millis() + retryDelay;
-      return;
-    }
-
-    // Successfully sent
-    lastResponseTime = millis();
-    pendingResponse = false;
-    LOG_INFO("Transmitted DISCOVER_RESP");
-  }
-}
-
 bool DiscoveryResponder::buildDiscoveryResponse(const uint8_t *requestPayload,
                                                 uint16_t requestLength,
                                                 int8_t requestSnr,
@@ -217,7 +193,7 @@ bool DiscoveryResponder::buildDiscoveryResponse(const uint8_t *requestPayload,
   packet.payloadLength = payloadIdx;
 
   // Encode packet
-  length = PacketDecoder::encode(packet, dest, 256);
+  length = PacketDecoder::encode(packet, dest, Config::Forwarding::MAX_ENCODED_PACKET_SIZE);
   if (length == 0) {
     LOG_ERROR("Failed to encode DISCOVER_RESP");
     return false;
@@ -25,10 +25,15 @@ public:
   ProcessResult processPacket(const PacketEvent &event,
                               ProcessingContext &ctx) override;
   const char *getName() const override { return "DiscoveryResponder"; }
-  uint8_t getPriority() const override { return 36; }
-
-  void loop();
-  bool hasPendingResponse() const { return pendingResponse; }
+  static constexpr uint8_t PRIORITY = 36;
+  uint8_t getPriority() const override { return PRIORITY; }
+  PacketInterest getInterest() const override {
+    // Zero-hop discovery arrives as DIRECT CONTROL
+    return PacketInterest::only(
+        PacketInterest::payload(PayloadType::CONTROL),
+        PacketInterest::route(RouteType::DIRECT) |
+            PacketInterest::route(RouteType::TRANSPORT_DIRECT));
+  }
 
 private:
   static constexpr uint32_t RESPONSE_RATE_LIMIT_MS = 60000; // 1 minute
@@ -39,12 +44,6 @@ private:
   uint32_t lastRequestTag;
   uint32_t lastRequestTime;
 
-  // Pending response
-  bool pendingResponse = false;
-  uint32_t responseTime = 0;
-  uint8_t pendingPacket[256];
-  uint16_t pendingPacketLength = 0;
-
   bool buildDiscoveryResponse(const uint8_t *requestPayload, 
                              uint16_t requestLength,
                              int8_t requestSnr,
@@ -15,6 +15,11 @@ public:
   MeshCore::ProcessResult processPacket(const MeshCore::PacketEvent &event,
                                        MeshCore::ProcessingContext &ctx) override;
   const char *getName() const override { return "NeighborMonitor"; }
-  uint8_t getPriority() const override { return 50; }  // Low priority, just observing
+  static constexpr uint8_t PRIORITY = 50;  // Low priority, just observing
+  uint8_t getPriority() const override { return PRIORITY; }
+  MeshCore::PacketInterest getInterest() const override {
+    return MeshCore::PacketInterest::only(
+        MeshCore::PacketInterest::payload(MeshCore::PayloadType::ADVERT));
+  }
 };
 
@@ -2,11 +2,17 @@
 #include "../../core/NodeConfig.h"
 #include "../../core/PacketDecoder.h"
 #include "../../core/PacketValidator.h"
+#include "../../radio/TxScheduler.h"
+#include "../RxDelayCurve.h"
 #include <Arduino.h>
 #include <string.h>
 
 namespace MeshCore {
 
+namespace {
+constexpr uint8_t PATH_HASH_SIZE = 1; // One node hash per hop in V1 protocol
+}
+
 ProcessResult PacketForwarder::processPacket(const PacketEvent &event,
                                              ProcessingContext &ctx) {
   if (!Config::Forwarding::ENABLED) {
@@ -37,80 +43,97 @@ ProcessResult PacketForwarder::processPacket(const PacketEvent &event,
 
   ctx.shouldForward = true;
 
-  // Create copy for modification
-  DecodedPacket forwardPacket;
-  memcpy(&forwardPacket, &event.packet, sizeof(DecodedPacket));
-  
-  // Handle path modification based on routing type
-  bool isDirect = (forwardPacket.routeType == RouteType::DIRECT ||
-                   forwardPacket.routeType == RouteType::TRANSPORT_DIRECT);
-  
-  if (isDirect) {
-    // For DIRECT routing, remove ourselves from the path
-    auto pathResult = removeSelfFromPath(forwardPacket);
-    if (pathResult.isError()) {
-      LOG_WARN_FMT("Cannot remove from path: %s",
-                   errorCodeToString(pathResult.error));
-      droppedCount++;
-      return ProcessResult::CONTINUE;
-    }
-  } else {
-    // For FLOOD routing, add ourselves to the path
-    auto pathResult = addNodeToPath(forwardPacket);
-    if (pathResult.isError()) {
-      LOG_WARN_FMT("Cannot add to path: %s",
-                   errorCodeToString(pathResult.error));
-      droppedCount++;
-      return ProcessResult::CONTINUE;
-    }
-  }
+  bool isDirect = (event.packet.routeType == RouteType::DIRECT ||
+                   event.packet.routeType == RouteType::TRANSPORT_DIRECT);
 
-  // Encode packet for transmission
-  uint8_t rawPacket[Config::Forwarding::MAX_ENCODED_PACKET_SIZE];
-  auto encodeResult = encodePacketForForwarding(forwardPacket, rawPacket, sizeof(rawPacket));
-  if (encodeResult.isError()) {
-    LOG_ERROR("Failed to encode packet for forwarding");
+  auto lengthResult = forwardFrameLength(event, isDirect);
+  if (lengthResult.isError()) {
+    LOG_WARN_FMT("Cannot build forward frame: %s",
+                 errorCodeToString(lengthResult.error));
     droppedCount++;
     return ProcessResult::CONTINUE;
   }
-  uint16_t length = encodeResult.value;
+  uint16_t length = lengthResult.value;
 
   // Log transport codes if present
-  if (forwardPacket.hasTransportCodes) {
+  if (event.packet.hasTransportCodes) {
     LOG_INFO_FMT("Forwarding packet with transport codes: [%d, %d]",
-                 forwardPacket.transportCodes[0], forwardPacket.transportCodes[1]);
+                 event.packet.transportCodes[0], event.packet.transportCodes[1]);
   }
 
   // Calculate delays based on routing type and signal quality
   uint32_t airtime = LoRaTransmitter::estimateAirtime(length);
-  uint32_t totalDelay;
+  uint32_t rxDelay = 0;
+  uint32_t txJitter;
   
   if (isDirect) {
     // DIRECT routing gets highest priority - minimal delay
     // Small jitter to avoid collisions when multiple nodes forward simultaneously
-    uint32_t txJitter = calculateTxJitter(airtime);
-    totalDelay = txJitter / 2; // Half the normal jitter for faster forwarding
-    LOG_INFO_FMT("DIRECT routing delay: %lu ms", totalDelay);
+    txJitter = calculateTxJitter(airtime) / 2; // Half the normal jitter for faster forwarding
+    LOG_INFO_FMT("DIRECT routing delay: %lu ms", txJitter);
   } else {
     // FLOOD routing uses SNR-based adaptive delay
-    float score = calculatePacketScore(event.snr);
-    uint32_t rxDelay = calculateRxDelay(score, airtime);
-    uint32_t txJitter = calculateTxJitter(airtime);
-    totalDelay = rxDelay + txJitter;
-    LOG_INFO_FMT("FLOOD routing delay: %lu ms (rxDelay=%lu, txJitter=%lu)", 
-                 totalDelay, rxDelay, txJitter);
+    uint32_t score = calculatePacketScore(event.snr);
+    rxDelay = calculateRxDelay(score, airtime);
+    txJitter = calculateTxJitter(airtime);
+    LOG_INFO_FMT("FLOOD routing delay: %lu ms (rxDelay=%lu, txJitter=%lu, score=%lu%%)", 
+                 rxDelay + txJitter, rxDelay, txJitter, (score * 100) >> 16);
   }
+  uint32_t totalDelay = rxDelay + txJitter;
 
   // Forward immediately or queue based on delay
   if (totalDelay < Config::Forwarding::MIN_DELAY_THRESHOLD_MS) {
-    handleImmediateForward(rawPacket, length, event.hash);
+    handleImmediateForward(event, isDirect, length);
   } else {
-    handleDelayedForward(rawPacket, length, totalDelay, event.snr, airtime);
+    handleDelayedForward(event, isDirect, length, rxDelay, txJitter);
   }
 
   return ProcessResult::CONTINUE;
 }
 
+void PacketForwarder::onDuplicate(uint32_t hash) {
+  if (Config::Forwarding::DUPLICATE_CANCEL_THRESHOLD == 0) {
+    return;
+  }
+
+  uint8_t slot = 0;
+  uint32_t deadline = 0;
+  bool found = false;
+  delayQueue.forEach([&](uint32_t entryDeadline, uint8_t entrySlot) {
+    // A DIRECT packet is ours alone to relay; copies are upstream retries
+    const DelayedPacket &entry = delayed[entrySlot];
+    if (!entry.isFlood || entry.hash != hash) {
+      return true;
+    }
+    slot = entrySlot;
+    deadline = entryDeadline;
+    found = true;
+    return false;
+  });
+  if (!found) {
+    return;
+  }
+
+  DelayedPacket &entry = delayed[slot];
+  entry.overheardCount++;
+  if (entry.overheardCount >= Config::Forwarding::DUPLICATE_CANCEL_THRESHOLD) {
+    delayQueue.remove(slot);
+    releaseSlot(slot);
+    suppressedCount++;
+    LOG_INFO_FMT("Cancelled forward hash=0x%08lX, heard %u relays (total: %lu)",
+                 hash, entry.overheardCount, suppressedCount);
+    return;
+  }
+
+  // Below threshold: back off one jitter slot to listen for more relays
+  uint32_t airtime = LoRaTransmitter::estimateAirtime(delayFrames.length(slot));
+  delayQueue.reschedule(
+      slot, deadline + static_cast<uint32_t>(
+                           airtime * Config::Forwarding::TX_DELAY_FACTOR));
+  LOG_DEBUG_FMT("Demoted forward hash=0x%08lX, heard %u relays", hash,
+                entry.overheardCount);
+}
+
 void PacketForwarder::loop() {
   if (processDelayQueue()) {
     forwardedCount++;
@@ -192,147 +215,124 @@ Result<void> PacketForwarder::transmitPacket(const uint8_t *rawPacket,
     return Err(ErrorCode::INVALID_PARAMETER);
   }
 
-  LoRaTransmitter &transmitter = LoRaTransmitter::getInstance();
+  // The scheduler sends it as soon as the radio and duty cycle allow
+  bool success = TxScheduler::getInstance().schedule(rawPacket, length, 0);
+  return success ? Ok() : Err(ErrorCode::QUEUE_FULL);
+}
 
-  if (transmitter.isTransmitting()) {
-    LOG_DEBUG("Transmitter busy, skipping forward");
-    return Err(ErrorCode::HARDWARE_ERROR);
+Result<uint16_t> PacketForwarder::forwardFrameLength(const PacketEvent &event,
+                                                     bool isDirect) const {
+  if (event.raw == nullptr) {
+    return Err<uint16_t>(ErrorCode::INVALID_PARAMETER);
   }
 
-  bool success = transmitter.transmit(rawPacket, length);
-  return success ? Ok() : Err(ErrorCode::TRANSMIT_FAILED);
-}
+  if (isDirect) {
+    if (event.packet.pathLength == 0) {
+      return Err<uint16_t>(ErrorCode::INVALID_PARAMETER);
+    }
+    return Ok<uint16_t>(event.rawLength - PATH_HASH_SIZE);
+  }
 
-Result<void> PacketForwarder::addNodeToPath(DecodedPacket &packet) {
-  // Validate we can add to path
-  auto canAddResult = PacketValidator::canAddToPath(packet);
+  auto canAddResult = PacketValidator::canAddToPath(event.packet);
   if (canAddResult.isError()) {
-    return canAddResult;
+    return Err<uint16_t>(canAddResult.error);
   }
-
-  uint8_t nodeHash = NodeConfig::getInstance().getNodeHash();
-
-  LOG_INFO_FMT("Adding node hash 0x%02X to path (current path_len=%d)",
-               nodeHash, packet.pathLength);
-
-  packet.path[packet.pathLength] = nodeHash;
-  packet.pathLength++;
-
-  LOG_INFO_FMT("Path updated, new path_len=%d", packet.pathLength);
-
-  return Ok();
+  uint16_t newLength = event.rawLength + PATH_HASH_SIZE;
+  if (newLength > Config::Queue::MAX_FRAME_SIZE) {
+    return Err<uint16_t>(ErrorCode::BUFFER_TOO_SMALL);
+  }
+  return Ok<uint16_t>(newLength);
 }
 
-Result<void> PacketForwarder::removeSelfFromPath(DecodedPacket &packet) {
-  // Validate we have at least one byte in path
-  if (packet.pathLength == 0) {
-    return Err(ErrorCode::INVALID_PARAMETER);
-  }
+void PacketForwarder::writeForwardFrame(const PacketEvent &event, bool isDirect,
+                                        uint8_t *frame) const {
+  const uint8_t *raw = event.raw;
+  uint16_t length = event.rawLength;
 
-  uint8_t nodeHash = NodeConfig::getInstance().getNodeHash();
-  
-  LOG_INFO_FMT("Removing node hash 0x%02X from DIRECT path (current path_len=%d)",
-               nodeHash, packet.pathLength);
+  // Frame layout: header, [transport codes], path length, path, payload.
+  // The decoder has already bounds-checked the path against the frame.
+  uint16_t pathLengthIndex =
+      event.packet.hasTransportCodes ? 1 + TRANSPORT_CODES_TOTAL_SIZE : 1;
+  uint8_t pathLength = raw[pathLengthIndex];
+  uint16_t pathEnd = pathLengthIndex + 1 + pathLength;
 
-  // Shift path left by 1 byte (PATH_HASH_SIZE = 1 in V1 protocol)
-  packet.pathLength--;
-  for (uint8_t i = 0; i < packet.pathLength; i++) {
-    packet.path[i] = packet.path[i + 1];
+  uint8_t nodeHash = NodeConfig::getInstance().getNodeHash();
+  if (isDirect) {
+    // We are the head of the path: drop our hash, keep the rest
+    memcpy(frame, raw, pathLengthIndex);
+    frame[pathLengthIndex] = pathLength - PATH_HASH_SIZE;
+    memcpy(frame + pathLengthIndex + 1,
+           raw + pathLengthIndex + 1 + PATH_HASH_SIZE,
+           length - pathLengthIndex - 1 - PATH_HASH_SIZE);
+  } else {
+    // Append our hash at the path tail, payload moves up by one
+    memcpy(frame, raw, pathEnd);
+    frame[pathLengthIndex] = pathLength + PATH_HASH_SIZE;
+    frame[pathEnd] = nodeHash;
+    memcpy(frame + pathEnd + PATH_HASH_SIZE, raw + pathEnd, length - pathEnd);
   }
 
-  LOG_INFO_FMT("Path updated, new path_len=%d", packet.pathLength);
-
-  return Ok();
+  LOG_INFO_FMT("%s node hash 0x%02X, path_len %d -> %d",
+               isDirect ? "Removed" : "Added", nodeHash, pathLength,
+               frame[pathLengthIndex]);
 }
 
-Result<uint16_t> PacketForwarder::encodePacketForForwarding(
-    const DecodedPacket &packet, uint8_t *buffer, uint16_t bufferSize) {
-  uint16_t length = PacketDecoder::encode(packet, buffer, bufferSize);
-  if (length == 0) {
-    return Err<uint16_t>(ErrorCode::ENCODE_ERROR);
+void PacketForwarder::handleImmediateForward(const PacketEvent &event,
+                                             bool isDirect, uint16_t length) {
+  // Built straight into the TX pool; it never waits, so it takes no delay
+  // queue slot and cannot evict queued forwards
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *frame = scheduler.acquire(handle);
+  if (frame == nullptr) {
+    LOG_WARN("Immediate transmit failed: TX pool full");
+    droppedCount++;
+    return;
+  }
+  writeForwardFrame(event, isDirect, frame);
+  if (!scheduler.submit(handle, length, 0)) {
+    LOG_WARN("Immediate transmit failed: invalid frame");
+    droppedCount++;
+    return;
   }
-  return Ok<uint16_t>(length);
+
+  forwardedCount++;
+  LOG_INFO_FMT("Forwarded immediately hash=0x%08lX (total: %lu)", event.hash,
+               forwardedCount);
 }
 
-void PacketForwarder::handleImmediateForward(const uint8_t *rawPacket, 
-                                             uint16_t length, uint32_t hash) {
-  auto txResult = transmitPacket(rawPacket, length);
-  if (txResult.isOk()) {
-    forwardedCount++;
-    LOG_INFO_FMT("Forwarded immediately hash=0x%08lX (total: %lu)",
-                 hash, forwardedCount);
-  } else {
-    LOG_WARN_FMT("Immediate transmit failed: %s",
-                 errorCodeToString(txResult.error));
+void PacketForwarder::handleDelayedForward(const PacketEvent &event,
+                                           bool isDirect, uint16_t length,
+                                           uint32_t rxDelay, uint32_t txJitter) {
+  // Patch the received frame straight into a delay queue slot
+  uint8_t slot = allocateSlot(classifyFrame(event.raw, event.rawLength), length);
+  if (slot == delayFrames.INVALID_SLOT) {
+    LOG_WARN("Delayed forward queue full, dropping packet");
     droppedCount++;
+    return;
   }
-}
+  writeForwardFrame(event, isDirect, delayFrames.data(slot));
 
-void PacketForwarder::handleDelayedForward(const uint8_t *rawPacket, 
-                                           uint16_t length, uint32_t totalDelay,
-                                           int8_t snr, uint32_t airtime) {
-  auto enqueueResult = enqueueDelayed(rawPacket, length, totalDelay);
+  uint32_t totalDelay = rxDelay + txJitter;
+  auto enqueueResult = enqueueDelayed(slot, totalDelay, event.hash, !isDirect);
   if (enqueueResult.isOk()) {
-    float score = calculatePacketScore(snr);
-    uint32_t scorePercent = static_cast<uint32_t>(score * 100.0f);
-    uint32_t rxDelay = calculateRxDelay(score, airtime);
-    uint32_t txJitter = calculateTxJitter(airtime);
     LOG_INFO_FMT("Queued for delayed forward: rxDelay=%lu ms, txJitter=%lu "
-                 "ms, total=%lu ms (score=%lu%%)",
-                 rxDelay, txJitter, totalDelay, scorePercent);
+                 "ms, total=%lu ms",
+                 rxDelay, txJitter, totalDelay);
   } else {
     LOG_WARN_FMT("Queue failed: %s", errorCodeToString(enqueueResult.error));
     droppedCount++;
   }
 }
 
-float PacketForwarder::calculatePacketScore(int8_t snr) const {
-  // Convert SNR from 0.25 dB units to dB
-  float snrFloat = static_cast<float>(snr) / Config::Forwarding::SNR_SCALE_FACTOR;
-  
-  // Normalize to 0.0 - 1.0 range
-  float normalized = (snrFloat - Config::Forwarding::SNR_MIN_DB) / 
-                     Config::Forwarding::SNR_RANGE_DB;
-  
-  // Clamp to valid range
-  normalized = max(0.0f, min(1.0f, normalized));
-  
-  return normalized;
+uint32_t PacketForwarder::calculatePacketScore(int8_t snr) const {
+  // Q16 score, 0 = SNR_MIN_DB or worse, 65536 = top of SNR_RANGE_DB
+  return RxDelayCurve::score(snr);
 }
 
-uint32_t PacketForwarder::calculateRxDelay(float score,
+uint32_t PacketForwarder::calculateRxDelay(uint32_t score,
                                            uint32_t airtime) const {
-  if (Config::Forwarding::RX_DELAY_BASE <= 0.0f) {
-    return 0;
-  }
-
-  // Use lookup table to approximate pow(2.5, 0.85 - score) - 1.0
-  // Precomputed for RX_DELAY_BASE = 2.5, exponents from -0.15 to 0.85
-  // Table has 11 entries for score values 0.0, 0.1, 0.2, ... 1.0
-  static const uint16_t multiplierTable[] = {
-    1293,  // score=0.0, exp=0.85  -> 2.5^0.85 - 1 = 2.293
-    1105,  // score=0.1, exp=0.75  -> 2.5^0.75 - 1 = 2.105
-    936,   // score=0.2, exp=0.65  -> 2.5^0.65 - 1 = 1.936
-    783,   // score=0.3, exp=0.55  -> 2.5^0.55 - 1 = 1.783
-    645,   // score=0.4, exp=0.45  -> 2.5^0.45 - 1 = 1.645
-    521,   // score=0.5, exp=0.35  -> 2.5^0.35 - 1 = 1.521
-    410,   // score=0.6, exp=0.25  -> 2.5^0.25 - 1 = 1.410
-    310,   // score=0.7, exp=0.15  -> 2.5^0.15 - 1 = 1.310
-    220,   // score=0.8, exp=0.05  -> 2.5^0.05 - 1 = 1.220
-    139,   // score=0.9, exp=-0.05 -> 2.5^-0.05 - 1 = 1.139
-    65     // score=1.0, exp=-0.15 -> 2.5^-0.15 - 1 = 1.065
-  };
-
-  // Convert score to table index (0-10)
-  uint8_t index = static_cast<uint8_t>(score * 10.0f);
-  if (index > 10) index = 10;
-
-  // Get multiplier from table (scaled by 1000)
-  uint32_t multiplier = multiplierTable[index];
-
-  // Calculate delay: (multiplier / 1000) * airtime
-  uint32_t rxDelay = (multiplier * airtime) / 1000;
-  return rxDelay;
+  return RxDelayCurve::delayMs(score, airtime);
 }
 
 uint32_t PacketForwarder::calculateTxJitter(uint32_t airtime) const {
@@ -342,38 +342,98 @@ uint32_t PacketForwarder::calculateTxJitter(uint32_t airtime) const {
   return randomSlot * slotTime;
 }
 
-Result<void> PacketForwarder::enqueueDelayed(const uint8_t *encodedPacket,
-                                             uint16_t length,
-                                             uint32_t delayMs) {
-  // Validate parameters
-  if (encodedPacket == nullptr) {
-    return Err(ErrorCode::INVALID_PARAMETER);
+uint8_t PacketForwarder::allocateSlot(TrafficClass trafficClass,
+                                      uint16_t length) {
+  uint8_t classIndex = static_cast<uint8_t>(trafficClass);
+
+  // Evicted frames may leave scattered gaps, so retry until one fits
+  while (true) {
+    if (hasSharedSlot(classIndex)) {
+      uint8_t slot = delayFrames.allocate(length);
+      if (slot != delayFrames.INVALID_SLOT) {
+        delayed[slot].trafficClass = trafficClass;
+        classCount[classIndex]++;
+        return slot;
+      }
+    }
+    if (!evictFor(classIndex)) {
+      return delayFrames.INVALID_SLOT;
+    }
   }
+}
 
-  if (length > Config::Forwarding::MAX_ENCODED_PACKET_SIZE) {
-    LOG_ERROR("Packet too large for delay queue");
-    return Err(ErrorCode::BUFFER_TOO_SMALL);
+void PacketForwarder::releaseSlot(uint8_t slot) {
+  classCount[static_cast<uint8_t>(delayed[slot].trafficClass)]--;
+  delayFrames.release(slot);
+}
+
+bool PacketForwarder::hasSharedSlot(uint8_t classIndex) const {
+  // Slots other classes have reserved but not yet used are off limits
+  size_t unusedReserve = 0;
+  for (uint8_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i) {
+    uint8_t reserved = Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[i];
+    if (i != classIndex && classCount[i] < reserved) {
+      unusedReserve += reserved - classCount[i];
+    }
   }
+  return delayFrames.getCount() + unusedReserve < DELAY_QUEUE_SIZE;
+}
 
-  if (delayQueue.isFull()) {
-    LOG_WARN("Delayed forward queue full, dropping packet");
-    return Err(ErrorCode::QUEUE_FULL);
+bool PacketForwarder::evictFor(uint8_t classIndex) {
+  bool belowReserve =
+      classCount[classIndex] <
+      Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[classIndex];
+
+  // Lowest class first; a class is never pushed below its own reserve
+  for (uint8_t i = TRAFFIC_CLASS_COUNT; i-- > 0;) {
+    if (i == classIndex || (i < classIndex && !belowReserve) ||
+        classCount[i] <= Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[i]) {
+      continue;
+    }
+
+    uint8_t victim = delayFrames.INVALID_SLOT;
+    uint32_t latest = 0;
+    delayQueue.forEach([&](uint32_t deadline, uint8_t slot) {
+      if (static_cast<uint8_t>(delayed[slot].trafficClass) == i &&
+          (victim == delayFrames.INVALID_SLOT ||
+           static_cast<int32_t>(deadline - latest) > 0)) {
+        victim = slot;
+        latest = deadline;
+      }
+      return true;
+    });
+    if (victim == delayFrames.INVALID_SLOT) {
+      continue;
+    }
+
+    delayQueue.remove(victim);
+    releaseSlot(victim);
+    classStats[i].evicted++;
+    LOG_INFO_FMT("Evicted %s forward hash=0x%08lX for a %s packet",
+                 trafficClassName(static_cast<TrafficClass>(i)),
+                 delayed[victim].hash,
+                 trafficClassName(static_cast<TrafficClass>(classIndex)));
+    return true;
   }
+  return false;
+}
 
+Result<void> PacketForwarder::enqueueDelayed(uint8_t slot, uint32_t delayMs,
+                                             uint32_t hash, bool isFlood) {
+  // The frame is already in delayFrames; only the deadline is new
   uint32_t scheduledTime = millis() + delayMs;
 
-  DelayedPacket delayed;
-  memcpy(delayed.encodedPacket, encodedPacket, length);
-  delayed.packetLength = length;
-  delayed.scheduledTime = scheduledTime;
-  delayed.valid = true;
-
-  bool inserted = delayQueue.insert(delayed, scheduledTime);
-  if (!inserted) {
+  if (!delayQueue.push(scheduledTime, slot)) {
+    releaseSlot(slot);
     return Err(ErrorCode::QUEUE_FULL);
   }
+  delayed[slot].hash = hash;
+  delayed[slot].queuedAt = millis();
+  delayed[slot].overheardCount = 0;
+  delayed[slot].isFlood = isFlood;
 
   delayedCount++;
+  classStats[static_cast<uint8_t>(delayed[slot].trafficClass)].enqueued++;
 
   LOG_DEBUG_FMT(
       "Queued packet for delayed forward in %lu ms (delayed count: %lu)",
@@ -382,57 +442,93 @@ Result<void> PacketForwarder::enqueueDelayed(const uint8_t *encodedPacket,
   return Ok();
 }
 
+bool PacketForwarder::getNextDeadline(uint32_t &deadline) const {
+  bool found = false;
+  delayQueue.forEach([&](uint32_t entryDeadline, uint8_t slot) {
+    if (canHandOver(delayed[slot].trafficClass) &&
+        (!found || static_cast<int32_t>(entryDeadline - deadline) < 0)) {
+      deadline = entryDeadline;
+      found = true;
+    }
+    return true;
+  });
+  return found;
+}
+
+bool PacketForwarder::canHandOver(TrafficClass trafficClass) const {
+  // Holding back keeps a forward cancellable by overheard relays; the
+  // scheduler would only send it after what it already holds anyway
+  return !LoRaTransmitter::getInstance().isTransmitting() &&
+         !TxScheduler::getInstance().hasPending(trafficClass);
+}
+
+bool PacketForwarder::selectDue(uint32_t now, uint8_t &slot) const {
+  bool found = false;
+  uint32_t bestDeadline = 0;
+  delayQueue.forEach([&](uint32_t deadline, uint8_t entrySlot) {
+    if (static_cast<int32_t>(now - deadline) < 0) {
+      return true;
+    }
+    // Stale forwards are taken first so they are dropped even while
+    // their class is held back
+    const DelayedPacket &entry = delayed[entrySlot];
+    if (now - entry.queuedAt >= Config::Forwarding::MAX_FORWARD_AGE_MS) {
+      slot = entrySlot;
+      found = true;
+      return false;
+    }
+    if (!canHandOver(entry.trafficClass)) {
+      return true;
+    }
+    if (!found || entry.trafficClass < delayed[slot].trafficClass ||
+        (entry.trafficClass == delayed[slot].trafficClass &&
+         static_cast<int32_t>(deadline - bestDeadline) < 0)) {
+      slot = entrySlot;
+      bestDeadline = deadline;
+      found = true;
+    }
+    return true;
+  });
+  return found;
+}
+
 bool PacketForwarder::processDelayQueue() {
   uint32_t now = millis();
   bool processed = false;
 
   // Process ALL ready packets in one iteration for lower latency
-  while (true) {
-    uint32_t frontTime;
-    if (!delayQueue.peekFrontKey(frontTime)) {
-      break; // Queue empty
-    }
-
-    if (now < frontTime) {
-      break; // Next packet not ready yet
+  uint8_t slot;
+  while (selectDue(now, slot)) {
+    // A forward that waited this long is no longer worth the airtime
+    DelayedPacket &entry = delayed[slot];
+    if (now - entry.queuedAt >= Config::Forwarding::MAX_FORWARD_AGE_MS) {
+      delayQueue.remove(slot);
+      releaseSlot(slot);
+      agedOutCount++;
+      LOG_INFO_FMT("Dropped stale forward hash=0x%08lX after %lu ms (total: %lu)",
+                   entry.hash, now - entry.queuedAt, agedOutCount);
+      continue;
     }
 
-    // Check if transmitter is available BEFORE popping from queue
-    // This matches PingResponder behavior - don't lose packet if busy
-    LoRaTransmitter &transmitter = LoRaTransmitter::getInstance();
-    if (transmitter.isTransmitting()) {
-      // Transmitter busy, leave packet in queue and retry next loop
+    uint16_t length = delayFrames.length(slot);
+    auto txResult = transmitPacket(delayFrames.data(slot), length);
+    if (txResult.isError()) {
+      // TX pool full; the scheduler owns retries once it has the frame,
+      // here the entry just waits a jitter slot until MAX_FORWARD_AGE_MS
+      uint32_t airtime = LoRaTransmitter::estimateAirtime(length);
+      delayQueue.reschedule(
+          slot, now + static_cast<uint32_t>(
+                          airtime * Config::Forwarding::TX_DELAY_FACTOR));
+      LOG_DEBUG_FMT("Forward hand-over failed: %s",
+                    errorCodeToString(txResult.error));
       break;
     }
 
-    // Now pop the packet - we know transmitter is available
-    DelayedPacket delayed;
-    if (delayQueue.popFront(delayed)) {
-      auto txResult =
-          transmitPacket(delayed.encodedPacket, delayed.packetLength);
-      if (txResult.isOk()) {
-        LOG_DEBUG("Transmitted delayed packet");
-        processed = true;
-        // Successfully transmitted, continue to next packet
-      } else {
-        // Transmit failed - re-insert with retry delay
-        // This matches PingResponder behavior - retry until success
-        uint32_t airtime = LoRaTransmitter::estimateAirtime(delayed.packetLength);
-        uint32_t retryDelay = static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
-        uint32_t retryTime = millis() + retryDelay;
-        
-        if (!delayQueue.insert(delayed, retryTime)) {
-          // Queue full, packet dropped
-          LOG_WARN_FMT("Failed to re-insert packet: %s",
-                       errorCodeToString(txResult.error));
-          droppedCount++;
-        }
-        // Stop processing queue after retry to avoid busy-looping
-        break;
-      }
-    } else {
-      break; // Failed to pop, shouldn't happen
-    }
+    LOG_DEBUG("Transmitted delayed packet");
+    delayQueue.remove(slot);
+    classStats[static_cast<uint8_t>(entry.trafficClass)].transmitted++;
+    releaseSlot(slot);
+    processed = true;
   }
 
   return processed;
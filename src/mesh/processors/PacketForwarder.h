@@ -3,25 +3,35 @@
 #include "../../core/Config.h"
 #include "../../core/Logger.h"
 #include "../../core/Result.h"
-#include "../../core/containers/PriorityQueue.h"
+#include "../../core/containers/DeadlineHeap.h"
+#include "../../core/containers/FrameSlab.h"
 #include "../../radio/LoRaTransmitter.h"
 #include "../PacketDispatcher.h"
+#include "../TrafficClass.h"
+#include "Deduplicator.h"
+#include <string.h>
 
 namespace MeshCore {
 
 /**
- * Delayed packet for priority queue
+ * Bookkeeping for a frame in the delay queue. The frame bytes live in
+ * the forwarder's FrameSlab under the same slot index.
  */
 struct DelayedPacket {
-  uint8_t encodedPacket[Config::Forwarding::MAX_ENCODED_PACKET_SIZE];
-  uint16_t packetLength;
-  uint32_t scheduledTime;
-  bool valid;
-
-  DelayedPacket()
-      : packetLength(0), scheduledTime(0), valid(false) {
-    memset(encodedPacket, 0, sizeof(encodedPacket));
-  }
+  uint32_t hash;          // Deduplicator hash, matches overheard copies
+  uint32_t queuedAt;      // millis() when queued, for MAX_FORWARD_AGE_MS
+  uint8_t overheardCount; // Neighbour relays heard while waiting
+  bool isFlood;
+  TrafficClass trafficClass;
+};
+
+/**
+ * Delay queue counters for one traffic class
+ */
+struct ForwardClassStats {
+  uint32_t enqueued;    // Admitted to the queue
+  uint32_t evicted;     // Pushed out by another class
+  uint32_t transmitted;
 };
 
 /**
@@ -36,52 +46,116 @@ struct DelayedPacket {
  * 
  * Forwarding is based on routing type, not payload type, ensuring protocol
  * compatibility with all message types.
+ *
+ * Queued FLOOD forwards are suppressed when neighbours are overheard
+ * relaying the same packet first (see DUPLICATE_CANCEL_THRESHOLD).
+ *
+ * Admission to the delay queue is by TrafficClass: each class has a
+ * reserved share of slots (DELAY_QUEUE_RESERVED_SLOTS), and a full queue
+ * evicts lower-class entries, latest deadline first. Due forwards leave
+ * highest class first, and only while the TxScheduler holds nothing of
+ * the same or a higher class, so a flood stuck behind the duty cycle
+ * does not hold back DIRECT, ACK or PATH forwards.
+ *
+ * The DeadlineHeap is only a container here: picking the due forward,
+ * the eviction victim and an overheard copy all depend on class or hash,
+ * so each is a linear scan over at most DELAY_QUEUE_SIZE 8-byte entries.
  */
-class PacketForwarder : public IPacketProcessor {
+class PacketForwarder : public IPacketProcessor, public IDuplicateListener {
 public:
-  PacketForwarder() : forwardedCount(0), droppedCount(0), delayedCount(0) {}
+  PacketForwarder()
+      : forwardedCount(0), droppedCount(0), delayedCount(0),
+        suppressedCount(0), agedOutCount(0) {
+    memset(classCount, 0, sizeof(classCount));
+    resetClassStats();
+  }
   ~PacketForwarder() override = default;
 
   ProcessResult processPacket(const PacketEvent &event,
                               ProcessingContext &ctx) override;
+  void onDuplicate(uint32_t hash) override;
   const char *getName() const override { return "PacketForwarder"; }
-  uint8_t getPriority() const override { return 20; }
+  static constexpr uint8_t PRIORITY = 20;
+  uint8_t getPriority() const override { return PRIORITY; }
+  PacketInterest getInterest() const override {
+    // TRACE and CONTROL have their own handlers
+    return PacketInterest::only(
+        PacketInterest::ALL_PAYLOAD_TYPES &
+        ~(PacketInterest::payload(PayloadType::TRACE) |
+          PacketInterest::payload(PayloadType::CONTROL)));
+  }
 
   void loop();
 
   uint32_t getForwardedCount() const { return forwardedCount; }
   uint32_t getDroppedCount() const { return droppedCount; }
   uint32_t getDelayedCount() const { return delayedCount; }
+  uint32_t getSuppressedCount() const { return suppressedCount; }
+  uint32_t getAgedOutCount() const { return agedOutCount; }
   bool hasPendingPackets() const { return !delayQueue.isEmpty(); }
 
+  // Deadline of the next forward that could be handed over now, false
+  // when none can (empty queue, or its class waits behind the scheduler)
+  bool getNextDeadline(uint32_t &deadline) const;
+
+  const ForwardClassStats &getClassStats(TrafficClass trafficClass) const {
+    return classStats[static_cast<uint8_t>(trafficClass)];
+  }
+  void resetClassStats() { memset(classStats, 0, sizeof(classStats)); }
+
 private:
   static constexpr size_t DELAY_QUEUE_SIZE =
       Config::Forwarding::DELAY_QUEUE_SIZE;
+  static constexpr size_t DELAY_QUEUE_BUFFER_SIZE =
+      Config::Forwarding::DELAY_QUEUE_BUFFER_SIZE;
+
+  static_assert(sizeof(Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS) ==
+                    TRAFFIC_CLASS_COUNT,
+                "DELAY_QUEUE_RESERVED_SLOTS needs one entry per traffic class");
+  static_assert(Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[0] +
+                        Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[1] +
+                        Config::Forwarding::DELAY_QUEUE_RESERVED_SLOTS[2] <=
+                    DELAY_QUEUE_SIZE,
+                "Reserved delay queue slots exceed DELAY_QUEUE_SIZE");
 
   uint32_t forwardedCount;
   uint32_t droppedCount;
   uint32_t delayedCount;
+  uint32_t suppressedCount;
+  uint32_t agedOutCount;      // Dropped after MAX_FORWARD_AGE_MS
 
-  PriorityQueue<DelayedPacket, DELAY_QUEUE_SIZE, uint32_t> delayQueue;
+  DeadlineHeap<DELAY_QUEUE_SIZE> delayQueue;
+  FrameSlab<DELAY_QUEUE_SIZE, DELAY_QUEUE_BUFFER_SIZE> delayFrames;
+  DelayedPacket delayed[DELAY_QUEUE_SIZE];
+  uint8_t classCount[TRAFFIC_CLASS_COUNT];  // Slots held per class
+  ForwardClassStats classStats[TRAFFIC_CLASS_COUNT];
 
   Result<void> shouldForward(const DecodedPacket &packet, int16_t rssi,
                              const ProcessingContext &ctx);
   Result<void> transmitPacket(const uint8_t *rawPacket, uint16_t length);
-  Result<void> addNodeToPath(DecodedPacket &packet);
-  Result<void> removeSelfFromPath(DecodedPacket &packet);
-  Result<uint16_t> encodePacketForForwarding(const DecodedPacket &packet, 
-                                              uint8_t *buffer, uint16_t bufferSize);
-  void handleImmediateForward(const uint8_t *rawPacket, uint16_t length, 
-                              uint32_t hash);
-  void handleDelayedForward(const uint8_t *rawPacket, uint16_t length,
-                            uint32_t totalDelay, int8_t snr, uint32_t airtime);
-
-  float calculatePacketScore(int8_t snr) const;
-  uint32_t calculateRxDelay(float score, uint32_t airtime) const;
+  Result<uint16_t> forwardFrameLength(const PacketEvent &event,
+                                      bool isDirect) const;
+  void writeForwardFrame(const PacketEvent &event, bool isDirect,
+                         uint8_t *frame) const;
+  void handleImmediateForward(const PacketEvent &event, bool isDirect,
+                              uint16_t length);
+  void handleDelayedForward(const PacketEvent &event, bool isDirect,
+                            uint16_t length, uint32_t rxDelay,
+                            uint32_t txJitter);
+
+  uint32_t calculatePacketScore(int8_t snr) const;
+  uint32_t calculateRxDelay(uint32_t score, uint32_t airtime) const;
   uint32_t calculateTxJitter(uint32_t airtime) const;
 
-  Result<void> enqueueDelayed(const uint8_t *encodedPacket, uint16_t length,
-                              uint32_t delayMs);
+  uint8_t allocateSlot(TrafficClass trafficClass, uint16_t length);
+  void releaseSlot(uint8_t slot);
+  bool hasSharedSlot(uint8_t classIndex) const;
+  bool evictFor(uint8_t classIndex);
+
+  Result<void> enqueueDelayed(uint8_t slot, uint32_t delayMs, uint32_t hash,
+                              bool isFlood);
+  bool canHandOver(TrafficClass trafficClass) const;
+  bool selectDue(uint32_t now, uint8_t &slot) const;
   bool processDelayQueue();
 };
 
@@ -13,7 +13,8 @@ public:
   ProcessResult processPacket(const PacketEvent &event,
                               ProcessingContext &ctx) override;
   const char *getName() const override { return "PacketLogger"; }
-  uint8_t getPriority() const override { return 99; }  // Last - just for debugging
+  static constexpr uint8_t PRIORITY = 99;  // Last - just for debugging
+  uint8_t getPriority() const override { return PRIORITY; }
 };
 
 } // namespace MeshCore
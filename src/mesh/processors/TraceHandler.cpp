@@ -1,7 +1,7 @@
 #include "TraceHandler.h"
 #include "../../core/NodeConfig.h"
 #include "../../core/PacketDecoder.h"
-#include "../../radio/LoRaTransmitter.h"
+#include "../../radio/TxScheduler.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -9,6 +9,10 @@ namespace MeshCore {
 
 ProcessResult TraceHandler::processPacket(const PacketEvent &event,
                                           ProcessingContext &ctx) {
+  if (!Config::Forwarding::ENABLED) {
+    return ProcessResult::CONTINUE;
+  }
+
   if (event.packet.payloadType != PayloadType::TRACE) {
     return ProcessResult::CONTINUE;
   }
@@ -108,34 +112,30 @@ bool TraceHandler::appendSnrAndForward(DecodedPacket &packet, int8_t snr) {
   LOG_INFO_FMT("Appended SNR=%d dB to TRACE path (new path_len=%d)", snrDb,
                packet.pathLength);
 
-  uint8_t rawPacket[256];
-  uint16_t length = PacketDecoder::encode(packet, rawPacket, sizeof(rawPacket));
-
-  if (length == 0) {
-    LOG_ERROR("Failed to encode TRACE packet");
+  TxScheduler &scheduler = TxScheduler::getInstance();
+  uint8_t handle;
+  uint8_t *rawPacket = scheduler.acquire(handle);
+  if (rawPacket == nullptr) {
+    LOG_WARN("TX queue full, cannot forward TRACE");
     return false;
   }
 
-  LoRaTransmitter &transmitter = LoRaTransmitter::getInstance();
-
-  if (transmitter.isTransmitting()) {
-    LOG_WARN("Transmitter busy, cannot forward TRACE");
-    return false;
-  }
-
-  if (!transmitter.canTransmitNow()) {
-    LOG_WARN("In silence period, cannot forward TRACE");
+  uint16_t length =
+      PacketDecoder::encode(packet, rawPacket, TxScheduler::MAX_FRAME_SIZE);
+  if (length == 0) {
+    LOG_ERROR("Failed to encode TRACE packet");
+    scheduler.discard(handle);
     return false;
   }
 
   // TRACE packets use DIRECT routing, so collision risk is lower than FLOOD
-  // No artificial delay needed - transmit immediately for lowest latency
-  if (transmitter.transmit(rawPacket, length)) {
+  // No artificial delay needed - send as soon as the radio is free
+  if (scheduler.submit(handle, length, 0)) {
     LOG_INFO("TRACE packet forwarded");
     return true;
   }
 
-  LOG_ERROR("Failed to transmit TRACE packet");
+  LOG_ERROR("Failed to queue TRACE packet");
   return false;
 }
 
@@ -14,7 +14,12 @@ public:
   ProcessResult processPacket(const PacketEvent &event,
                               ProcessingContext &ctx) override;
   const char *getName() const override { return "TraceHandler"; }
-  uint8_t getPriority() const override { return 30; }
+  static constexpr uint8_t PRIORITY = 30;
+  uint8_t getPriority() const override { return PRIORITY; }
+  PacketInterest getInterest() const override {
+    // All routes, so non-DIRECT traces are still seen and dropped
+    return PacketInterest::only(PacketInterest::payload(PayloadType::TRACE));
+  }
 
   uint32_t getTracesHandled() const { return tracesHandled; }
 
@@ -1,6 +1,7 @@
 #include "PowerManager.h"
 #include "../core/Config.h"
 #include "../core/Logger.h"
+#include <LoRaWan_APP.h>
 
 // CubeCell low-power API
 extern "C" {
@@ -9,12 +10,19 @@ extern "C" {
   void lowPowerHandler(void);
 }
 
+namespace {
+// RTC alarm bounding a timed sleep; waking is all it needs to do
+TimerEvent_t wakeTimer;
+void onWakeTimer() {}
+} // namespace
+
 PowerManager &PowerManager::getInstance() {
   static PowerManager instance;
   return instance;
 }
 
 void PowerManager::initialize() {
+  TimerInit(&wakeTimer, onWakeTimer);
   LOG_INFO("Power management initialized");
   if (Config::Power::LIGHT_SLEEP_ENABLED) {
     LOG_INFO("Light sleep mode enabled");
@@ -31,10 +39,19 @@ void PowerManager::sleep(uint32_t maxSleepMs) {
   }
 
   // Power optimization: Enter light sleep immediately
-  // The lowPowerHandler() will wake on any interrupt (LoRa, etc.)
+  // The lowPowerHandler() will wake on any interrupt (LoRa, etc.); with a
+  // limit, the RTC wake timer is one of them
   uint32_t sleepStart = millis();
+  if (maxSleepMs > 0) {
+    TimerSetValue(&wakeTimer, maxSleepMs);
+    TimerStart(&wakeTimer);
+  }
   
   lowPowerHandler();
+
+  if (maxSleepMs > 0) {
+    TimerStop(&wakeTimer);
+  }
   
   // Handle millis() overflow safely: the subtraction works correctly due to
   // unsigned integer wraparound, but only accumulate if the result is reasonable
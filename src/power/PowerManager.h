@@ -6,14 +6,15 @@
  * Power Management for Heltec CubeCell (ASR6501)
  * 
  * Provides light sleep mode while maintaining continuous radio reception.
- * The MCU sleeps between operations and wakes on radio interrupts.
+ * The MCU sleeps between operations and wakes on radio interrupts, or
+ * after maxSleepMs via an RTC timer when sleep() is given a limit.
  */
 class PowerManager {
 public:
   static PowerManager &getInstance();
 
   void initialize();
-  void sleep(uint32_t maxSleepMs = 0);
+  void sleep(uint32_t maxSleepMs = 0);  // 0 = until the next interrupt
   bool canSleep() const;
   void preventSleep();
   void allowSleep();
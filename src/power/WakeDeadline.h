@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Earliest of several millis() deadlines, used to size a timed sleep.
+ * Deadlines are compared with wraparound, as in DeadlineHeap.
+ *
+ *   WakeDeadline wake(millis());
+ *   if (forwarder.getNextDeadline(deadline)) wake.add(deadline);
+ *   ...
+ *   PowerManager::getInstance().sleep(wake.remainingMs());
+ */
+class WakeDeadline {
+public:
+  explicit WakeDeadline(uint32_t now) : now(now), earliest(0), pending(false) {}
+
+  void add(uint32_t deadline) {
+    if (!pending || static_cast<int32_t>(deadline - earliest) < 0) {
+      earliest = deadline;
+      pending = true;
+    }
+  }
+
+  bool isPending() const { return pending; }
+
+  // Time left until the earliest deadline, 0 once it is due
+  uint32_t remainingMs() const {
+    int32_t remaining = static_cast<int32_t>(earliest - now);
+    return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+  }
+
+private:
+  uint32_t now;
+  uint32_t earliest;
+  bool pending;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../core/Config.h"
+#include <stdint.h>
+
+/**
+ * LoRa time-on-air (SX1261/2 datasheet 6.1.4, Semtech AN1200.13),
+ * evaluated at compile time.
+ *
+ *   Tsym     = 2^SF / BW
+ *   Tpre     = (Npreamble + 4.25) * Tsym          (SF5/6: + 6.25)
+ *   Npayload = 8 + ceil(max(8*PL - 4*SF + 8 + 16*CRC + 20*EH, 0) /
+ *                       (4*(SF - 2*DE))) * (CR + 4)
+ *
+ * SF5/6 drop the "+ 8" term. CR is 1..4 for 4/5..4/8, EH is 1 with an
+ * explicit header, and DE (low data rate optimisation) is on when
+ * Tsym >= 16 ms, as the radio driver sets it. Times are kept in
+ * nanoseconds and divided once so every bandwidth rounds only once.
+ */
+namespace Airtime {
+
+// Radio.SetRxConfig/SetTxConfig bandwidth index -> Hz
+constexpr uint32_t bandwidthHz(uint8_t index) {
+  return index == 0   ? 125000
+         : index == 1 ? 250000
+         : index == 2 ? 500000
+         : index == 3 ? 62500
+         : index == 4 ? 41670
+         : index == 5 ? 31250
+         : index == 6 ? 20830
+         : index == 7 ? 15630
+         : index == 8 ? 10420
+                      : 7810;
+}
+
+constexpr uint64_t symbolTimeNs(uint8_t sf, uint32_t bwHz) {
+  return (static_cast<uint64_t>(1) << sf) * 1000000000ull / bwHz;
+}
+
+constexpr bool lowDataRateOptimize(uint8_t sf, uint32_t bwHz) {
+  return symbolTimeNs(sf, bwHz) >= 16000000ull;
+}
+
+constexpr int32_t ceilDiv(int32_t numerator, int32_t denominator) {
+  return numerator <= 0 ? 0 : (numerator + denominator - 1) / denominator;
+}
+
+constexpr uint32_t payloadSymbols(uint16_t length, uint8_t sf, uint8_t cr,
+                                  bool crc, bool implicitHeader, bool ldro) {
+  return 8 + static_cast<uint32_t>(
+                 ceilDiv(8 * length - 4 * sf + (sf < 7 ? 0 : 8) +
+                             (crc ? 16 : 0) + (implicitHeader ? 0 : 20),
+                         4 * (sf - (ldro ? 2 : 0))) *
+                 (cr + 4));
+}
+
+constexpr uint64_t timeOnAirNs(uint16_t length, uint8_t sf, uint32_t bwHz,
+                               uint8_t cr, uint16_t preamble, bool crc,
+                               bool implicitHeader) {
+  // Count quarter symbols so (preamble + 4.25) stays integral, and divide
+  // by the bandwidth once at the end
+  return (static_cast<uint64_t>(1) << sf) * 1000000000ull *
+         (4u * preamble + (sf < 7 ? 25 : 17) +
+          4u * payloadSymbols(length, sf, cr, crc, implicitHeader,
+                              lowDataRateOptimize(sf, bwHz))) /
+         (4ull * bwHz);
+}
+
+constexpr uint32_t timeOnAirUs(uint16_t length, uint8_t sf, uint32_t bwHz,
+                               uint8_t cr, uint16_t preamble, bool crc,
+                               bool implicitHeader) {
+  return static_cast<uint32_t>(
+      (timeOnAirNs(length, sf, bwHz, cr, preamble, crc, implicitHeader) + 500) /
+      1000);
+}
+
+// Time on air for the radio as configured in Config::LoRa, rounded up to ms
+constexpr uint32_t configuredMs(uint16_t length) {
+  return static_cast<uint32_t>(
+      (timeOnAirNs(length, Config::LoRa::SPREADING_FACTOR,
+                   bandwidthHz(Config::LoRa::BANDWIDTH),
+                   Config::LoRa::CODING_RATE, Config::LoRa::PREAMBLE_LENGTH,
+                   Config::LoRa::CRC_ENABLED,
+                   Config::LoRa::FIXED_LENGTH_PAYLOAD) +
+       999999) /
+      1000000);
+}
+
+// Per-length table for the configured radio, built at compile time
+constexpr uint16_t MAX_LENGTH = 255;
+
+struct Table {
+  uint16_t ms[MAX_LENGTH + 1];
+};
+
+template <uint16_t... Is> struct Indices {};
+template <uint16_t N, uint16_t... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+template <uint16_t... Is> struct MakeIndices<0, Is...> {
+  typedef Indices<Is...> Type;
+};
+
+template <uint16_t... Is> constexpr Table buildTable(Indices<Is...>) {
+  return Table{{static_cast<uint16_t>(configuredMs(Is))...}};
+}
+
+static_assert(configuredMs(MAX_LENGTH) <= 0xFFFF,
+              "Airtime table entries must fit uint16_t for this LoRa config");
+
+// Datasheet reference points: 13-byte frame, CR 4/5, 8-symbol preamble
+static_assert(timeOnAirUs(13, 7, 125000, 1, 8, true, false) == 46336,
+              "SF7/125 kHz time on air");
+static_assert(timeOnAirUs(13, 12, 125000, 1, 8, true, false) == 1155072,
+              "SF12/125 kHz time on air (low data rate optimisation)");
+
+} // namespace Airtime
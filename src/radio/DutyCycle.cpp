@@ -0,0 +1,118 @@
+#include "DutyCycle.h"
+#include <string.h>
+
+void AirtimeLedger::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  bucketStart = millis();
+  currentIndex = 0;
+  usedMs = 0;
+}
+
+void AirtimeLedger::advance(uint32_t now) {
+  uint32_t steps = (now - bucketStart) / BUCKET_MS;
+  if (steps == 0) {
+    return;
+  }
+  bucketStart += steps * BUCKET_MS;
+  if (steps >= BUCKET_COUNT) {
+    memset(buckets, 0, sizeof(buckets));
+    usedMs = 0;
+    return;
+  }
+  for (uint32_t i = 0; i < steps; ++i) {
+    currentIndex = (currentIndex + 1) % BUCKET_COUNT;
+    usedMs -= buckets[currentIndex];
+    buckets[currentIndex] = 0;
+  }
+}
+
+void AirtimeLedger::record(uint32_t airtimeMs, uint32_t now) {
+  advance(now);
+  uint16_t &slot = buckets[currentIndex];
+  uint32_t room = BUCKET_MS - slot;
+  uint32_t added = min(airtimeMs, room);
+  slot += static_cast<uint16_t>(added);
+  usedMs += added;
+}
+
+uint32_t AirtimeLedger::getUsedMs(uint32_t now) {
+  advance(now);
+  return usedMs;
+}
+
+uint16_t DutyCycle::limitPermille() {
+  for (const Config::DutyCycle::SubBand &band : Config::DutyCycle::SUB_BANDS) {
+    if (Config::LoRa::FREQUENCY >= band.minHz &&
+        Config::LoRa::FREQUENCY < band.maxHz) {
+      return band.limitPermille;
+    }
+  }
+  return Config::DutyCycle::DEFAULT_LIMIT_PERMILLE;
+}
+
+uint32_t DutyCycle::budgetMs() {
+  return Config::DutyCycle::WINDOW_MS / 1000 * limitPermille();
+}
+
+uint32_t DutyCycle::capacityUs() {
+  return min(Config::DutyCycle::BURST_MS, budgetMs()) * 1000;
+}
+
+void DutyCycle::reset() {
+  ledger.reset();
+  tokensUs = capacityUs();
+  lastRefill = millis();
+  deferredCount[0] = 0;
+  deferredCount[1] = 0;
+}
+
+void DutyCycle::refill(uint32_t now) {
+  // limitPermille ms of credit per second = limitPermille us per ms
+  uint32_t elapsed = now - lastRefill;
+  lastRefill = now;
+  uint32_t capacity = capacityUs();
+  if (elapsed >= capacity / limitPermille()) {
+    tokensUs = capacity;
+    return;
+  }
+  tokensUs = min(capacity, tokensUs + elapsed * limitPermille());
+}
+
+bool DutyCycle::canTransmit(uint32_t airtimeMs, TxPriority priority,
+                            uint32_t now) {
+  if (!Config::DutyCycle::ENABLED) {
+    return true;
+  }
+
+  refill(now);
+
+  uint32_t budget = budgetMs();
+  uint32_t used = ledger.getUsedMs(now);
+  uint32_t windowReserve = 0;
+  uint32_t tokenReserve = 0;
+  if (priority == TxPriority::NORMAL) {
+    windowReserve = budget / 100 * Config::DutyCycle::HIGH_PRIORITY_RESERVE_PERCENT;
+    tokenReserve = capacityUs() / 100 * Config::DutyCycle::HIGH_PRIORITY_RESERVE_PERCENT;
+  }
+
+  bool fitsWindow = used + airtimeMs + windowReserve <= budget;
+  bool fitsTokens = static_cast<uint64_t>(airtimeMs) * 1000 + tokenReserve <= tokensUs;
+  if (fitsWindow && fitsTokens) {
+    return true;
+  }
+
+  deferredCount[static_cast<uint8_t>(priority)]++;
+  return false;
+}
+
+void DutyCycle::recordTransmission(uint32_t airtimeMs, uint32_t now) {
+  refill(now);
+  ledger.record(airtimeMs, now);
+  uint32_t cost = airtimeMs * 1000;
+  tokensUs = (cost < tokensUs) ? tokensUs - cost : 0;
+}
+
+uint16_t DutyCycle::getUsagePermille(uint32_t now) {
+  return static_cast<uint16_t>(static_cast<uint64_t>(ledger.getUsedMs(now)) * 1000 /
+                               Config::DutyCycle::WINDOW_MS);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../core/Config.h"
+#include "../mesh/TrafficClass.h"
+#include <Arduino.h>
+
+enum class TxPriority : uint8_t { HIGH, NORMAL };
+
+/**
+ * Sliding-window airtime ledger for one sub-band.
+ * Airtime is summed into BUCKET_COUNT buckets; buckets older than the
+ * window are cleared as time moves on. Time is only compared as a
+ * difference, so the ledger keeps its history across a millis() wrap.
+ */
+class AirtimeLedger {
+public:
+  static constexpr uint8_t BUCKET_COUNT = Config::DutyCycle::BUCKET_COUNT;
+  static constexpr uint32_t BUCKET_MS = Config::DutyCycle::WINDOW_MS / BUCKET_COUNT;
+
+  static_assert(BUCKET_MS <= 0xFFFF, "Ledger buckets must fit uint16_t ms");
+
+  AirtimeLedger() { reset(); }
+
+  void reset();
+  void record(uint32_t airtimeMs, uint32_t now);
+  uint32_t getUsedMs(uint32_t now);
+
+private:
+  uint16_t buckets[BUCKET_COUNT];
+  uint32_t bucketStart;   // millis() at which the current bucket began
+  uint8_t currentIndex;
+  uint32_t usedMs;
+
+  void advance(uint32_t now);
+};
+
+/**
+ * Regulatory duty-cycle engine.
+ *
+ * A transmission is allowed when it fits both the sliding 1 h ledger and
+ * a token bucket that refills at the duty-cycle rate. NORMAL traffic
+ * must leave HIGH_PRIORITY_RESERVE_PERCENT of each budget untouched, so
+ * TrafficClass::HIGH frames (DIRECT, ACK, PATH, TRACE) still get out
+ * when floods have exhausted their share.
+ */
+class DutyCycle {
+public:
+  DutyCycle() { reset(); }
+
+  void reset();
+  bool canTransmit(uint32_t airtimeMs, TxPriority priority, uint32_t now);
+  void recordTransmission(uint32_t airtimeMs, uint32_t now);
+
+  uint32_t getUsedMs(uint32_t now) { return ledger.getUsedMs(now); }
+  uint16_t getUsagePermille(uint32_t now);
+  uint32_t getDeferredCount(TxPriority priority) const {
+    return deferredCount[static_cast<uint8_t>(priority)];
+  }
+
+  static TxPriority priorityOf(MeshCore::TrafficClass trafficClass) {
+    return trafficClass == MeshCore::TrafficClass::HIGH ? TxPriority::HIGH
+                                                        : TxPriority::NORMAL;
+  }
+  static uint16_t limitPermille();
+  static uint32_t budgetMs();
+
+private:
+  AirtimeLedger ledger;
+  uint32_t tokensUs;        // Airtime credit in microseconds
+  uint32_t lastRefill;
+  uint32_t deferredCount[2];
+
+  static uint32_t capacityUs();
+  void refill(uint32_t now);
+};
@@ -1,5 +1,6 @@
 #include "LoRaReceiver.h"
 #include "../core/Logger.h"
+#include "../core/Profiler.h"
 #include "../core/PacketValidator.h"
 #include "../mesh/PacketDispatcher.h"
 #include "LoRaTransmitter.h"
@@ -32,7 +33,8 @@ void LoRaReceiver::initialize() {
   Radio.SetRxConfig(MODEM_LORA, Config::LoRa::BANDWIDTH,
                     Config::LoRa::SPREADING_FACTOR, Config::LoRa::CODING_RATE,
                     0, Config::LoRa::PREAMBLE_LENGTH, 0,
-                    Config::LoRa::FIXED_LENGTH_PAYLOAD, 0, true, 0, 0,
+                    Config::LoRa::FIXED_LENGTH_PAYLOAD, 0,
+                    Config::LoRa::CRC_ENABLED, 0, 0,
                     Config::LoRa::IQ_INVERSION, true);
 
   LOG_DEBUG_FMT("Setting sync word to 0x%02X", Config::LoRa::SYNC_WORD);
@@ -43,7 +45,8 @@ void LoRaReceiver::initialize() {
   Radio.SetTxConfig(MODEM_LORA, Config::LoRa::TX_POWER, 0,
                     Config::LoRa::BANDWIDTH, Config::LoRa::SPREADING_FACTOR,
                     Config::LoRa::CODING_RATE, Config::LoRa::PREAMBLE_LENGTH,
-                    Config::LoRa::FIXED_LENGTH_PAYLOAD, true, 0, 0,
+                    Config::LoRa::FIXED_LENGTH_PAYLOAD,
+                    Config::LoRa::CRC_ENABLED, 0, 0,
                     Config::LoRa::IQ_INVERSION, Config::LoRa::TX_TIMEOUT_MS);
 
   LOG_INFO("Starting continuous reception with RX boost");
@@ -52,16 +55,56 @@ void LoRaReceiver::initialize() {
 
 void LoRaReceiver::processQueue() {
   MeshCore::QueuedPacket queuedPacket;
+  MeshCore::DecodedPacket packet;
+
+  if (getInstance().packetQueue.isEmpty()) {
+    return;
+  }
+  PROFILE_START(drainStart);
 
+  IRxFilter *filter = getInstance().rxFilter;
   while (getInstance().packetQueue.dequeue(queuedPacket)) {
-    MeshCore::PacketEvent event(queuedPacket.packet, queuedPacket.rssi,
-                                queuedPacket.snr, queuedPacket.timestamp);
+    // Frames are queued raw; decode here, outside the radio callback
+    PROFILE_START(decodeStart);
+    if (!MeshCore::PacketDecoder::decode(queuedPacket.data, queuedPacket.length,
+                                         packet)) {
+      PROFILE_SECTION(RX_DECODE, decodeStart);
+      LOG_WARN("Failed to decode packet");
+      if (filter != nullptr && queuedPacket.tag != 0) {
+        filter->onDropped(queuedPacket.tag);
+      }
+      continue;
+    }
+
+    auto packetValidation = MeshCore::PacketValidator::validate(
+        packet, MeshCore::ValidationLevel::BASIC);
+    if (packetValidation.isError()) {
+      PROFILE_SECTION(RX_DECODE, decodeStart);
+      LOG_WARN_FMT("Decoded packet validation failed: %s",
+                   MeshCore::errorCodeToString(packetValidation.error));
+      if (filter != nullptr && queuedPacket.tag != 0) {
+        filter->onDropped(queuedPacket.tag);
+      }
+      continue;
+    }
+
+    packetCount++; // Increment packet counter for successfully decoded packets
+    PROFILE_SECTION(RX_DECODE, decodeStart);
+
+    MeshCore::PacketEvent event(packet, queuedPacket.data, queuedPacket.length,
+                                queuedPacket.rssi, queuedPacket.snr,
+                                queuedPacket.timestamp,
+                                filter != nullptr && queuedPacket.tag != 0 &&
+                                    filter->cachesQueuedFrames());
     MeshCore::PacketDispatcher::getInstance().dispatchPacket(event);
   }
+
+  PROFILE_SECTION(QUEUE_DRAIN, drainStart);
 }
 
 void LoRaReceiver::onRxDone(uint8_t *payload, uint16_t size, int16_t rssi,
                             int8_t snr) {
+  PROFILE_START(callbackStart);
   LOG_INFO_FMT("RX: %d bytes, RSSI: %d dBm, SNR: %d dB", size,
                rssi, snr);  // Framework already provides SNR in dB
 
@@ -69,12 +112,13 @@ void LoRaReceiver::onRxDone(uint8_t *payload, uint16_t size, int16_t rssi,
   uint32_t rxAirtime = LoRaTransmitter::estimateAirtime(size);
   totalRxAirtimeMs += rxAirtime;
 
-  // Validate raw packet before decoding
+  // Validate raw packet before queueing
   auto validationResult = MeshCore::PacketValidator::validateRawPacket(payload, size);
   if (validationResult.isError()) {
     LOG_WARN_FMT("Invalid raw packet: %s", 
                  MeshCore::errorCodeToString(validationResult.error));
     Radio.RxBoosted(0);
+    PROFILE_SECTION(RX_CALLBACK, callbackStart);
     return;
   }
 
@@ -85,30 +129,27 @@ void LoRaReceiver::onRxDone(uint8_t *payload, uint16_t size, int16_t rssi,
     // Continue anyway, just warn
   }
 
-  MeshCore::DecodedPacket packet;
-  bool decoded = MeshCore::PacketDecoder::decode(payload, size, packet);
+  uint32_t timestamp = millis();
 
-  if (decoded) {
-    // Validate decoded packet structure
-    auto packetValidation = MeshCore::PacketValidator::validate(
-        packet, MeshCore::ValidationLevel::BASIC);
-    if (packetValidation.isError()) {
-      LOG_WARN_FMT("Decoded packet validation failed: %s",
-                   MeshCore::errorCodeToString(packetValidation.error));
-      Radio.RxBoosted(0);
-      return;
-    }
+  // Keep queue slots for frames someone will act on
+  IRxFilter *filter = getInstance().rxFilter;
+  uint32_t tag = 0;
+  if (filter != nullptr && !filter->accept(payload, size, timestamp, tag)) {
+    Radio.RxBoosted(0);
+    PROFILE_SECTION(RX_CALLBACK, callbackStart);
+    return;
+  }
 
-    uint32_t timestamp = millis();
-    // MeshCore expects SNR in 0.25 dB units, so multiply by 4
-    int8_t snrScaled = snr * 4;
-    getInstance().packetQueue.enqueue(packet, rssi, snrScaled, timestamp);
-    packetCount++; // Increment packet counter for successfully decoded packets
-  } else {
-    LOG_WARN("Failed to decode packet");
+  // MeshCore expects SNR in 0.25 dB units, so multiply by 4
+  int8_t snrScaled = snr * 4;
+  if (getInstance().packetQueue.enqueue(payload, size, rssi, snrScaled,
+                                        timestamp, tag) &&
+      filter != nullptr) {
+    filter->onQueued(tag, timestamp);
   }
 
   Radio.RxBoosted(0);
+  PROFILE_SECTION(RX_CALLBACK, callbackStart);
 }
 
 void LoRaReceiver::onRxTimeout() {
@@ -5,6 +5,30 @@
 #include "../mesh/PacketQueue.h"
 #include "LoRaWan_APP.h"
 
+/**
+ * Decides in the RX callback whether a raw frame is worth a queue slot.
+ * accept() may set a tag (0 for none) that is queued with the frame and
+ * passed to onQueued, and to onDropped if the frame is evicted from the
+ * queue or fails to decode.
+ */
+class IRxFilter : public MeshCore::IQueueDropListener {
+public:
+  virtual ~IRxFilter() = default;
+  virtual bool accept(const uint8_t *frame, uint16_t length,
+                      uint32_t timestamp, uint32_t &tag) = 0;
+
+  // Called once the frame accept() last passed is in the RX queue
+  virtual void onQueued(uint32_t tag, uint32_t timestamp) {
+    (void)tag;
+    (void)timestamp;
+  }
+  void onDropped(uint32_t tag) override { (void)tag; }
+
+  // true if onQueued caches tagged frames in the Deduplicator, so
+  // dispatch must not take its own entry for a duplicate
+  virtual bool cachesQueuedFrames() const { return false; }
+};
+
 class LoRaReceiver {
 public:
   static LoRaReceiver &getInstance();
@@ -13,6 +37,10 @@ public:
   void processQueue();
 
   MeshCore::PacketQueue &getQueue() { return packetQueue; }
+  void setRxFilter(IRxFilter *filter) {
+    rxFilter = filter;
+    packetQueue.setDropListener(filter);
+  }
   
   static uint32_t getPacketCount() { return packetCount; }
   static uint32_t getTotalRxAirtimeMs() { return totalRxAirtimeMs; }
@@ -20,7 +48,7 @@ public:
   static void resetStats();
 
 private:
-  LoRaReceiver() = default;
+  LoRaReceiver() : rxFilter(nullptr) {}
 
   static void onRxDone(uint8_t *payload, uint16_t size, int16_t rssi,
                        int8_t snr);
@@ -28,6 +56,7 @@ private:
   static void onRxError();
 
   MeshCore::PacketQueue packetQueue;
+  IRxFilter *rxFilter;
   static uint32_t packetCount;
   static uint32_t totalRxAirtimeMs;
 
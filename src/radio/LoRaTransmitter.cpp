@@ -1,9 +1,15 @@
 #include "LoRaTransmitter.h"
 #include "../core/Logger.h"
+#include "Airtime.h"
+#include "TxScheduler.h"
 #include <Arduino.h>
 
 extern RadioEvents_t radioEvents;
 
+// Time on air per frame length for Config::LoRa, computed at compile time
+static constexpr Airtime::Table AIRTIME_TABLE =
+    Airtime::buildTable(Airtime::MakeIndices<Airtime::MAX_LENGTH + 1>::Type());
+
 LoRaTransmitter &LoRaTransmitter::getInstance() {
   static LoRaTransmitter instance;
   return instance;
@@ -11,7 +17,10 @@ LoRaTransmitter &LoRaTransmitter::getInstance() {
 
 void LoRaTransmitter::initialize() {
   LOG_DEBUG("Initializing LoRa transmitter");
-  nextAllowedTxTime = 0;
+  dutyCycle.reset();
+  LOG_INFO_FMT("Duty cycle limit: %u.%u%% (%s)", DutyCycle::limitPermille() / 10,
+               DutyCycle::limitPermille() % 10,
+               Config::DutyCycle::ENABLED ? "enforced" : "tracked only");
   LOG_INFO("LoRa transmitter ready");
 }
 
@@ -26,6 +35,7 @@ void LoRaTransmitter::onTxDone() {
   tx.notifyTxComplete(true);
   LOG_DEBUG("TX complete, returning to RX");
   Radio.RxBoosted(0);  // Return to boosted RX mode
+  TxScheduler::getInstance().onTxComplete();
 }
 
 void LoRaTransmitter::onTxTimeout() {
@@ -33,6 +43,7 @@ void LoRaTransmitter::onTxTimeout() {
   tx.notifyTxComplete(false);
   LOG_WARN("TX timeout, returning to RX");
   Radio.RxBoosted(0);  // Return to boosted RX mode
+  TxScheduler::getInstance().onTxComplete();
 }
 
 bool LoRaTransmitter::transmit(const uint8_t *data, uint16_t length) {
@@ -41,30 +52,33 @@ bool LoRaTransmitter::transmit(const uint8_t *data, uint16_t length) {
     return false;
   }
 
-  if (!canTransmitNow()) {
-    uint32_t waitTime = nextAllowedTxTime - millis();
-    LOG_DEBUG_FMT("In silence period, must wait %lu ms", waitTime);
-    return false;
-  }
-
   if (data == nullptr || length == 0 || length > 255) {
     LOG_ERROR("Invalid transmit parameters");
     failureCount++;
     return false;
   }
 
+  if (!canTransmitNow(data, length)) {
+    LOG_DEBUG_FMT("Duty cycle budget exhausted, deferring %d bytes", length);
+    return false;
+  }
+
   LOG_DEBUG_FMT("Transmitting %d bytes", length);
 
   transmitting = true;
   txStartTime = millis();
   transmitCount++;
+  // Charge the estimate up front so back-to-back decisions see it
+  dutyCycle.recordTransmission(estimateAirtime(length), txStartTime);
   Radio.Send(const_cast<uint8_t *>(data), length);
 
   return true;
 }
 
-bool LoRaTransmitter::canTransmitNow() const {
-  return millis() >= nextAllowedTxTime;
+bool LoRaTransmitter::canTransmitNow(const uint8_t *data, uint16_t length) {
+  return dutyCycle.canTransmit(
+      estimateAirtime(length),
+      DutyCycle::priorityOf(MeshCore::classifyFrame(data, length)), millis());
 }
 
 void LoRaTransmitter::notifyTxComplete(bool success) {
@@ -73,9 +87,6 @@ void LoRaTransmitter::notifyTxComplete(bool success) {
   if (success) {
     uint32_t airtime = millis() - txStartTime;
     totalAirtimeMs += airtime;
-    
-    // Duty cycle enforcement disabled
-    nextAllowedTxTime = millis();
 
     LOG_DEBUG_FMT("TX complete, airtime: %lu ms", airtime);
   } else {
@@ -84,26 +95,10 @@ void LoRaTransmitter::notifyTxComplete(bool success) {
 }
 
 uint32_t LoRaTransmitter::estimateAirtime(uint16_t packetLength) {
-  // Pre-computed constants for SF8, BW=62.5kHz, CR=4/4, Preamble=16
-  // Symbol duration = (2^SF / BW) * 1000 ms = (256 / 62500) * 1000 = 4.096 ms
-  // Preamble symbols = 16 + 4.25 = 20.25 symbols
-  
-  // For better accuracy with integer math, work in microseconds (scale by 1000)
-  // Symbol duration in microseconds: 4096 us
-  constexpr uint32_t SYMBOL_DURATION_US = 4096;
-  
-  // Preamble time in microseconds: 20.25 * 4096 = 82944 us
-  constexpr uint32_t PREAMBLE_TIME_US = 82944;
-  
-  // Payload calculation: 8 + ceil((8*PL - 32 + 28 + 16) / 32) * 8
-  // Simplified: 8 + ceil((8*PL + 12) / 32) * 8
-  uint32_t numerator = (8 * packetLength + 12);
-  uint32_t payloadSymbols = 8 + (((numerator + 31) / 32) * 8);  // ceil division
-  
-  uint32_t payloadTime = payloadSymbols * SYMBOL_DURATION_US;
-  uint32_t totalTime = (PREAMBLE_TIME_US + payloadTime) / 1000;  // Convert to ms
-  
-  return totalTime;
+  if (packetLength > Airtime::MAX_LENGTH) {
+    packetLength = Airtime::MAX_LENGTH;
+  }
+  return AIRTIME_TABLE.ms[packetLength];
 }
 
 void LoRaTransmitter::resetStats() {
@@ -2,6 +2,7 @@
 
 #include "../core/Config.h"
 #include "../core/PacketDecoder.h"
+#include "DutyCycle.h"
 #include "LoRaWan_APP.h"
 
 class LoRaTransmitter {
@@ -11,12 +12,13 @@ public:
   void initialize();
   bool transmit(const uint8_t *data, uint16_t length);
   bool isTransmitting() const { return transmitting; }
-  bool canTransmitNow() const;
+  bool canTransmitNow(const uint8_t *data, uint16_t length);
   void notifyTxComplete(bool success);
 
   uint32_t getTransmitCount() const { return transmitCount; }
   uint32_t getFailureCount() const { return failureCount; }
   uint32_t getTotalAirtimeMs() const { return totalAirtimeMs; }
+  DutyCycle &getDutyCycle() { return dutyCycle; }
   void resetStats();
 
   static uint32_t estimateAirtime(uint16_t packetLength);
@@ -26,7 +28,7 @@ public:
 private:
   LoRaTransmitter()
       : transmitting(false), transmitCount(0), failureCount(0),
-        totalAirtimeMs(0), txStartTime(0), nextAllowedTxTime(0) {}
+        totalAirtimeMs(0), txStartTime(0) {}
   
   static void onTxDone();
   static void onTxTimeout();
@@ -36,7 +38,7 @@ private:
   uint32_t failureCount;
   uint32_t totalAirtimeMs;
   uint32_t txStartTime;
-  uint32_t nextAllowedTxTime;
+  DutyCycle dutyCycle;
 
   LoRaTransmitter(const LoRaTransmitter &) = delete;
   LoRaTransmitter &operator=(const LoRaTransmitter &) = delete;
@@ -0,0 +1,165 @@
+#include "TxScheduler.h"
+#include "../core/Logger.h"
+#include "LoRaTransmitter.h"
+#include <string.h>
+
+TxScheduler &TxScheduler::getInstance() {
+  static TxScheduler instance;
+  return instance;
+}
+
+uint8_t *TxScheduler::acquire(uint8_t &handle) {
+  handle = frames.allocate(MAX_FRAME_SIZE);
+  if (handle == frames.INVALID_SLOT) {
+    rejectedCount++;
+    LOG_WARN("TX pool full, cannot build frame");
+    return nullptr;
+  }
+  return frames.data(handle);
+}
+
+bool TxScheduler::submit(uint8_t handle, uint16_t length, uint32_t delayMs,
+                         ITxListener *listener) {
+  if (handle >= SLOTS || length == 0 || length > frames.length(handle)) {
+    discard(handle);
+    return false;
+  }
+
+  frames.shrink(handle, length);
+  classes[handle] = MeshCore::classifyFrame(frames.data(handle), length);
+  queuedAt[handle] = millis();
+  attempts[handle] = 0;
+  listeners[handle] = listener;
+  queue.push(queuedAt[handle] + delayMs, handle);
+  LOG_DEBUG_FMT("TX queued %u bytes in %lu ms (%u pending)", length, delayMs,
+                static_cast<unsigned>(queue.size()));
+
+  // Send at once if it is due and the radio is free
+  loop();
+  return true;
+}
+
+void TxScheduler::discard(uint8_t handle) {
+  if (handle < SLOTS) {
+    frames.release(handle);
+  }
+}
+
+bool TxScheduler::schedule(const uint8_t *frame, uint16_t length,
+                           uint32_t delayMs) {
+  if (frame == nullptr || length == 0 || length > Config::Queue::MAX_FRAME_SIZE) {
+    return false;
+  }
+
+  uint8_t handle = frames.allocate(length);
+  if (handle == frames.INVALID_SLOT) {
+    rejectedCount++;
+    LOG_WARN_FMT("TX pool full, dropping %u byte frame", length);
+    return false;
+  }
+  memcpy(frames.data(handle), frame, length);
+  return submit(handle, length, delayMs);
+}
+
+void TxScheduler::loop() {
+  LoRaTransmitter &transmitter = LoRaTransmitter::getInstance();
+  if (queue.isEmpty() || transmitter.isTransmitting()) {
+    return;
+  }
+
+  uint32_t now = millis();
+  uint8_t slot;
+  while (selectDue(now, slot)) {
+    uint16_t length = frames.length(slot);
+    if (now - queuedAt[slot] >= Config::Tx::MAX_FRAME_AGE_MS) {
+      // Nothing was sent, so the next due frame can still go now
+      giveUp(slot, length);
+      continue;
+    }
+    if (!transmitter.transmit(frames.data(slot), length)) {
+      // Duty cycle budget exhausted: back off, up to RETRY_MAX_ATTEMPTS
+      attempts[slot]++;
+      if (attempts[slot] >= Config::Tx::RETRY_MAX_ATTEMPTS) {
+        giveUp(slot, length);
+        return;
+      }
+      uint32_t backoff =
+          retryBackoff(LoRaTransmitter::estimateAirtime(length), attempts[slot]);
+      queue.reschedule(slot, now + backoff);
+      deferredCount++;
+      LOG_DEBUG_FMT("TX deferred by duty cycle, retry %u in %lu ms",
+                    attempts[slot], backoff);
+      return;
+    }
+
+    // The radio has taken its own copy of the frame
+    if (attempts[slot] > 0) {
+      retrySuccessCount++;
+    }
+    queue.remove(slot);
+    frames.release(slot);
+    sentCount++;
+    if (listeners[slot] != nullptr) {
+      listeners[slot]->onFrameSent();
+    }
+    return;
+  }
+}
+
+void TxScheduler::giveUp(uint8_t slot, uint16_t length) {
+  queue.remove(slot);
+  frames.release(slot);
+  gaveUpCount++;
+  LOG_WARN_FMT("TX gave up on %u byte frame after %u attempts (total: %lu)",
+               length, attempts[slot], gaveUpCount);
+  if (listeners[slot] != nullptr) {
+    listeners[slot]->onFrameDropped();
+  }
+}
+
+uint32_t TxScheduler::retryBackoff(uint32_t airtime, uint8_t attempt) {
+  // slot << (attempt - 1), plus up to one slot so retries spread out
+  uint32_t slotTime =
+      static_cast<uint32_t>(airtime * Config::Forwarding::TX_DELAY_FACTOR);
+  uint8_t shift = attempt > 0 ? attempt - 1 : 0;
+  return (slotTime << shift) + random(0, slotTime + 1);
+}
+
+void TxScheduler::onTxComplete() { loop(); }
+
+bool TxScheduler::getNextDeadline(uint32_t &deadline) const {
+  uint8_t slot;
+  return queue.peek(deadline, slot);
+}
+
+bool TxScheduler::isIdle() const {
+  return queue.isEmpty() && !LoRaTransmitter::getInstance().isTransmitting();
+}
+
+bool TxScheduler::hasPending(MeshCore::TrafficClass trafficClass) const {
+  bool found = false;
+  queue.forEach([&](uint32_t, uint8_t slot) {
+    found = classes[slot] <= trafficClass;
+    return !found;
+  });
+  return found;
+}
+
+bool TxScheduler::selectDue(uint32_t now, uint8_t &slot) const {
+  bool found = false;
+  uint32_t bestDeadline = 0;
+  queue.forEach([&](uint32_t deadline, uint8_t entrySlot) {
+    if (static_cast<int32_t>(now - deadline) < 0) {
+      return true;
+    }
+    if (!found || classes[entrySlot] < classes[slot] ||
+        (classes[entrySlot] == classes[slot] &&
+         static_cast<int32_t>(deadline - bestDeadline) < 0)) {
+      slot = entrySlot;
+      bestDeadline = deadline;
+      found = true;
+    }
+    return true;
+  });
+  return found;
+}
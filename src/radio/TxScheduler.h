@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../core/Config.h"
+#include "../core/containers/DeadlineHeap.h"
+#include "../core/containers/FrameSlab.h"
+#include "../mesh/TrafficClass.h"
+#include <Arduino.h>
+
+/**
+ * Told what became of a submitted frame
+ */
+class ITxListener {
+public:
+  virtual ~ITxListener() = default;
+  virtual void onFrameSent() = 0;     // Handed to the radio
+  virtual void onFrameDropped() = 0;  // Given up on, never sent
+};
+
+/**
+ * Single owner of the transmitter.
+ *
+ * Encoded frames wait in a shared FrameSlab pool with a deadline. Once
+ * due they are sent highest TrafficClass first, then earliest deadline.
+ * The next frame is started from the TX done / timeout callbacks and
+ * from loop() when a deadline passes, so callers hand a frame over once
+ * and never poll for a free radio. Frames refused by the duty cycle are
+ * retried with exponential backoff and dropped after
+ * Config::Tx::RETRY_MAX_ATTEMPTS refusals or MAX_FRAME_AGE_MS.
+ *
+ * Writers may build straight into the pool:
+ *
+ *   uint8_t handle;
+ *   uint8_t *frame = TxScheduler::getInstance().acquire(handle);
+ *   uint16_t length = encode(frame, ...);
+ *   TxScheduler::getInstance().submit(handle, length, delayMs);
+ */
+class TxScheduler {
+public:
+  static constexpr uint8_t INVALID_HANDLE = 0xFF;
+  static constexpr uint16_t MAX_FRAME_SIZE =
+      Config::Forwarding::MAX_ENCODED_PACKET_SIZE;
+
+  static TxScheduler &getInstance();
+
+  /**
+   * Reserve a MAX_FRAME_SIZE buffer in the pool
+   *
+   * @return Buffer to encode into, or nullptr if the pool is full
+   */
+  uint8_t *acquire(uint8_t &handle);
+
+  /**
+   * Queue an acquired frame, trimmed to length, for delayMs from now.
+   * listener, if given, hears whether it was sent or dropped.
+   */
+  bool submit(uint8_t handle, uint16_t length, uint32_t delayMs,
+              ITxListener *listener = nullptr);
+
+  /**
+   * Return an acquired frame that will not be sent
+   */
+  void discard(uint8_t handle);
+
+  /**
+   * Copy a finished frame into the pool and queue it
+   */
+  bool schedule(const uint8_t *frame, uint16_t length, uint32_t delayMs);
+
+  // Start the best due frame if the radio is free
+  void loop();
+  void onTxComplete();
+
+  bool getNextDeadline(uint32_t &deadline) const;
+  bool isIdle() const;
+
+  /**
+   * Whether a frame of trafficClass or a higher class is queued
+   */
+  bool hasPending(MeshCore::TrafficClass trafficClass) const;
+  size_t getPendingCount() const { return queue.size(); }
+
+  uint32_t getSentCount() const { return sentCount; }
+  uint32_t getDeferredCount() const { return deferredCount; }
+  uint32_t getRejectedCount() const { return rejectedCount; }
+  uint32_t getRetrySuccessCount() const { return retrySuccessCount; }
+  uint32_t getGaveUpCount() const { return gaveUpCount; }
+
+private:
+  TxScheduler()
+      : sentCount(0), deferredCount(0), rejectedCount(0), retrySuccessCount(0),
+        gaveUpCount(0) {}
+
+  static constexpr size_t SLOTS = Config::Tx::QUEUE_SLOTS;
+  static constexpr size_t BUFFER_SIZE = Config::Tx::QUEUE_BUFFER_SIZE;
+
+  static_assert(BUFFER_SIZE >= MAX_FRAME_SIZE,
+                "TX pool must hold at least one frame being built");
+  static_assert(Config::Tx::RETRY_MAX_ATTEMPTS >= 1 &&
+                    Config::Tx::RETRY_MAX_ATTEMPTS <= 16,
+                "RETRY_MAX_ATTEMPTS must keep the backoff shift in range");
+
+  MeshCore::FrameSlab<SLOTS, BUFFER_SIZE> frames;
+  MeshCore::DeadlineHeap<SLOTS> queue;
+  MeshCore::TrafficClass classes[SLOTS];
+  uint32_t queuedAt[SLOTS];  // millis() at submit, for MAX_FRAME_AGE_MS
+  uint8_t attempts[SLOTS];   // Duty cycle refusals so far
+  ITxListener *listeners[SLOTS];
+
+  uint32_t sentCount;
+  uint32_t deferredCount;      // Retries scheduled after a duty cycle refusal
+  uint32_t rejectedCount;      // Pool full
+  uint32_t retrySuccessCount;  // Sent after at least one refusal
+  uint32_t gaveUpCount;        // Dropped after RETRY_MAX_ATTEMPTS or MAX_FRAME_AGE_MS
+
+  bool selectDue(uint32_t now, uint8_t &slot) const;
+  void giveUp(uint8_t slot, uint16_t length);
+  static uint32_t retryBackoff(uint32_t airtime, uint8_t attempt);
+
+  TxScheduler(const TxScheduler &) = delete;
+  TxScheduler &operator=(const TxScheduler &) = delete;
+};